@@ -0,0 +1,1079 @@
+#include <benchmark.h>
+#include <clarum/clarum.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+/*
+ * Benchmarks parser and handlers over synthetic schemas and argument vectors.
+ * Every measurement is printed as single JSON object per line, so that output
+ * of different releases may be collected and compared by scripts.
+ */
+
+/* Number of tags available to synthetic options. */
+#define numberOfTags 52
+
+/* Number of prepared values each handler cycles through. */
+#define numberOfValues 4096
+
+typedef struct {
+    cla_option_t *options;
+    cla_slot_t *slots;
+    char (*names)[24];
+    char (*synonyms)[24];
+    cla_schema_t schema;
+} schema_t;
+
+typedef struct {
+    char **argv;
+    char *storage;
+    int argc;
+    /* Number of options resolved while parsing argv. */
+    size_t numberOfLookups;
+} arguments_t;
+
+typedef struct {
+    char const *filter;
+    uint64_t duration;
+    size_t repetitions;
+    size_t maximumNumberOfThreads;
+    cla_list_t numbersOfOptions;
+    cla_list_t numbersOfArguments;
+} settings_t;
+
+static uint64_t
+    state = 88172645463325252u;
+
+static uint64_t
+getRandomNumber(
+    void
+) {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return state;
+}
+
+static double
+getTime(
+    void
+) {
+    struct timespec
+        time;
+
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return (double) time.tv_sec * 1e9 + (double) time.tv_nsec;
+}
+
+static char
+getTag(
+    size_t index
+) {
+    return (char) (index < 26 ? 'a' + index : 'A' + index - 26);
+}
+
+static bool
+isSelected(
+    settings_t const *settings,
+    char const *benchmark
+) {
+    return !settings->filter || strstr(benchmark, settings->filter);
+}
+
+/* Options are named 'o<index>'; every third one has synonym 's<index>', first ones have tags. */
+static bool
+makeSchema(
+    schema_t *schema,
+    size_t numberOfOptions
+) {
+    schema->options = calloc(numberOfOptions, sizeof *schema->options);
+    schema->slots = calloc(cla_numberOfSlots(numberOfOptions), sizeof *schema->slots);
+    schema->names = calloc(numberOfOptions, sizeof *schema->names);
+    schema->synonyms = calloc(numberOfOptions, sizeof *schema->synonyms);
+
+    if (!schema->options || !schema->slots || !schema->names || !schema->synonyms)
+        return false;
+
+    for (size_t i = 0; i < numberOfOptions; ++i) {
+        cla_option_t const
+            option = {
+                .tag = i < numberOfTags ? getTag(i) : '\0',
+                .name = schema->names[i],
+                .synonym = i % 3 ? NULL : schema->synonyms[i],
+            };
+
+        snprintf(schema->names[i], sizeof schema->names[i], "o%zu", i);
+        snprintf(schema->synonyms[i], sizeof schema->synonyms[i], "s%zu", i);
+        memcpy(&schema->options[i], &option, sizeof option);
+    }
+
+    schema->schema = (cla_schema_t) {
+        .options = schema->options,
+        .numberOfOptions = numberOfOptions,
+        .slots = schema->slots,
+        .numberOfSlots = cla_numberOfSlots(numberOfOptions),
+    };
+
+    return !cla_compileSchema(&schema->schema);
+}
+
+static void
+freeSchema(
+    schema_t *schema
+) {
+    free(schema->options);
+    free(schema->slots);
+    free(schema->names);
+    free(schema->synonyms);
+}
+
+/* Mixes long options with and without values, synonyms, short options and bundles. */
+static bool
+makeArguments(
+    arguments_t *arguments,
+    size_t numberOfOptions,
+    size_t numberOfArguments
+) {
+    size_t const
+        argumentSize = 48,
+        numberOfTagged = numberOfOptions < numberOfTags ? numberOfOptions : numberOfTags;
+
+    arguments->argv = calloc(numberOfArguments + 1, sizeof *arguments->argv);
+    arguments->storage = calloc(numberOfArguments, argumentSize);
+    arguments->argc = (int) numberOfArguments + 1;
+    arguments->numberOfLookups = 0;
+
+    if (!arguments->argv || !arguments->storage)
+        return false;
+
+    arguments->argv[0] = "binary";
+
+    for (size_t i = 0; i < numberOfArguments; ++i) {
+        char
+            *argument = &arguments->storage[i * argumentSize];
+        size_t const
+            index = getRandomNumber() % numberOfOptions;
+
+        switch (i % 6) {
+        case 0:
+            snprintf(argument, argumentSize, "--o%zu=%zu", index, i);
+            break;
+        case 1:
+            snprintf(argument, argumentSize, "--o%zu", index);
+            break;
+        case 2:
+            snprintf(argument, argumentSize, "--s%zu", index - index % 3);
+            break;
+        case 3:
+            snprintf(argument, argumentSize, "-%c", getTag(index % numberOfTagged));
+            break;
+        case 4:
+            snprintf(argument, argumentSize, "-%c=%zu", getTag(index % numberOfTagged), i);
+            break;
+        default:
+            snprintf(argument, argumentSize, "-%c%c%c", getTag(index % numberOfTagged),
+                getTag((index + 1) % numberOfTagged), getTag((index + 2) % numberOfTagged));
+            arguments->numberOfLookups += 2;
+            break;
+        }
+
+        arguments->argv[i + 1] = argument;
+        ++arguments->numberOfLookups;
+    }
+
+    return true;
+}
+
+static void
+freeArguments(
+    arguments_t *arguments
+) {
+    free(arguments->argv);
+    free(arguments->storage);
+}
+
+/* Returns best mean duration of single run in ns, repeating runs for at least settings duration. */
+static double
+measure(
+    settings_t const *settings,
+    void (*run)(void *context),
+    void *context
+) {
+    double
+        best = 0;
+
+    for (size_t repetition = 0; repetition < settings->repetitions; ++repetition) {
+        double const
+            start = getTime();
+        double
+            elapsed;
+        size_t
+            numberOfRuns = 0;
+
+        do {
+            run(context);
+            ++numberOfRuns;
+            elapsed = getTime() - start;
+        } while (elapsed < (double) settings->duration);
+
+        if (!repetition || elapsed / (double) numberOfRuns < best)
+            best = elapsed / (double) numberOfRuns;
+    }
+
+    return best;
+}
+
+typedef struct {
+    schema_t const *schema;
+    arguments_t const *arguments;
+    cla_result_t *result;
+} parse_t;
+
+static void
+runParse(
+    void *context
+) {
+    parse_t const
+        *parse = context;
+
+    if (cla_parse(&parse->schema->schema, parse->result, parse->arguments->argc, parse->arguments->argv))
+        fprintf(stderr, "clarum_bench: unexpected parse failure\n"), exit(EXIT_FAILURE);
+}
+
+static void
+benchmarkParse(
+    settings_t const *settings
+) {
+    uint64_t const
+        *numbersOfOptions = settings->numbersOfOptions.items,
+        *numbersOfArguments = settings->numbersOfArguments.items;
+
+    for (size_t i = 0; i < settings->numbersOfOptions.numberOfItems; ++i) {
+        size_t const
+            numberOfOptions = numbersOfOptions[i];
+        schema_t
+            schema;
+        char
+            **values = calloc(numberOfOptions, sizeof *values);
+        uint64_t
+            *references = calloc(cla_numberOfWords(numberOfOptions), sizeof *references);
+
+        if (!numberOfOptions || !values || !references || !makeSchema(&schema, numberOfOptions))
+            fprintf(stderr, "clarum_bench: cannot build schema of %zu options\n", numberOfOptions), exit(EXIT_FAILURE);
+
+        for (size_t j = 0; j < settings->numbersOfArguments.numberOfItems; ++j) {
+            size_t const
+                numberOfArguments = numbersOfArguments[j];
+            arguments_t
+                arguments;
+            cla_result_t
+                result = {
+                    .arguments = values,
+                    .references = references,
+                };
+            parse_t
+                parse = {
+                    .schema = &schema,
+                    .arguments = &arguments,
+                    .result = &result,
+                };
+            double
+                duration;
+
+            if (!numberOfArguments || !makeArguments(&arguments, numberOfOptions, numberOfArguments))
+                fprintf(stderr, "clarum_bench: cannot build %zu arguments\n", numberOfArguments), exit(EXIT_FAILURE);
+
+            duration = measure(settings, &runParse, &parse);
+            printf("{\"benchmark\": \"parse\", \"options\": %zu, \"arguments\": %zu, "
+                "\"ns_per_argument\": %.2f, \"ns_per_lookup\": %.2f}\n",
+                numberOfOptions, numberOfArguments,
+                duration / (double) numberOfArguments, duration / (double) arguments.numberOfLookups);
+
+            freeArguments(&arguments);
+        }
+
+        freeSchema(&schema);
+        free(values);
+        free(references);
+    }
+}
+
+typedef struct {
+    size_t jobs;
+    bool isVerbose;
+    bool isQuiet;
+    char *output;
+    char *input;
+    uint64_t timeout;
+    size_t bufferSize;
+} values_t;
+
+typedef struct {
+    cla_parser_t *parser;
+    int (*parse)(cla_parser_t *parser, int argc, char **argv);
+    int argc;
+    char **argv;
+} specialization_t;
+
+static void
+runSpecialization(
+    void *context
+) {
+    specialization_t const
+        *specialization = context;
+
+    if (specialization->parse(specialization->parser, specialization->argc, specialization->argv))
+        fprintf(stderr, "clarum_bench: unexpected parse failure\n"), exit(EXIT_FAILURE);
+}
+
+/* Arguments of typical command line tool, matching benchmark schema. */
+static char const
+    *const vocabulary[] = {
+        "--jobs=8", "--parallel=4", "-v", "-vq", "--quiet", "--output=file.txt", "-o=out",
+        "--input=in", "--timeout=250ms", "--buffer-size=64k", "-f", "--dry-run", "--simulate",
+        "--colour", "-c", "--verbose=on",
+    };
+
+/* Compares interpreting parser, with and without index, to parser generated for the same schema. */
+static void
+benchmarkGenerated(
+    settings_t const *settings
+) {
+    uint64_t const
+        *numbersOfArguments = settings->numbersOfArguments.items;
+    cla_option_t
+        options[] = benchmark_options;
+    cla_slot_t
+        slots[cla_numberOfSlots(benchmark_numberOfOptions)];
+    cla_schema_t
+        schema = {
+            .options = options,
+            .numberOfOptions = benchmark_numberOfOptions,
+            .slots = slots,
+            .numberOfSlots = sizeof slots / sizeof *slots,
+        };
+    cla_parser_t
+        scanningParser = {
+            .options = options,
+            .numberOfOptions = benchmark_numberOfOptions,
+        },
+        indexedParser = {
+            .options = options,
+            .numberOfOptions = benchmark_numberOfOptions,
+            .schema = &schema,
+        };
+    struct {
+        char const *name;
+        cla_parser_t *parser;
+        int (*parse)(cla_parser_t *parser, int argc, char **argv);
+    } const
+        parsers[] = {
+            {"scan", &scanningParser, &cla_parseOptions},
+            {"index", &indexedParser, &cla_parseOptions},
+            {"generated", &scanningParser, &benchmark_parseOptions},
+        };
+    values_t
+        values;
+
+    options[benchmark_jobs].valuePtr = &values.jobs;
+    options[benchmark_verbose].valuePtr = &values.isVerbose;
+    options[benchmark_quiet].valuePtr = &values.isQuiet;
+    options[benchmark_output].valuePtr = &values.output;
+    options[benchmark_input].valuePtr = &values.input;
+    options[benchmark_timeout].valuePtr = &values.timeout;
+    options[benchmark_bufferSize].valuePtr = &values.bufferSize;
+
+    if (cla_compileSchema(&schema))
+        fprintf(stderr, "clarum_bench: cannot compile schema\n"), exit(EXIT_FAILURE);
+
+    for (size_t i = 0; i < settings->numbersOfArguments.numberOfItems; ++i) {
+        size_t const
+            numberOfArguments = numbersOfArguments[i];
+        char
+            **argv = calloc(numberOfArguments + 1, sizeof *argv);
+
+        if (!numberOfArguments || !argv)
+            fprintf(stderr, "clarum_bench: cannot build %zu arguments\n", numberOfArguments), exit(EXIT_FAILURE);
+
+        argv[0] = "binary";
+        for (size_t j = 1; j <= numberOfArguments; ++j)
+            argv[j] = (char *) vocabulary[getRandomNumber() % (sizeof vocabulary / sizeof *vocabulary)];
+
+        for (size_t j = 0; j < sizeof parsers / sizeof *parsers; ++j) {
+            specialization_t
+                specialization = {
+                    .parser = parsers[j].parser,
+                    .parse = parsers[j].parse,
+                    .argc = (int) numberOfArguments + 1,
+                    .argv = argv,
+                };
+            double const
+                duration = measure(settings, &runSpecialization, &specialization);
+
+            printf("{\"benchmark\": \"generated\", \"parser\": \"%s\", \"arguments\": %zu, "
+                "\"ns_per_argument\": %.2f}\n",
+                parsers[j].name, numberOfArguments, duration / (double) numberOfArguments);
+        }
+
+        free(argv);
+    }
+}
+
+typedef struct {
+    cla_schema_t const *schema;
+    cla_cache_t *cache;
+    cla_result_t *result;
+    int argc;
+    char **argv;
+} cached_t;
+
+static void
+runUncached(
+    void *context
+) {
+    cached_t const
+        *cached = context;
+
+    if (cla_parse(cached->schema, cached->result, cached->argc, cached->argv))
+        fprintf(stderr, "clarum_bench: unexpected parse failure\n"), exit(EXIT_FAILURE);
+}
+
+static void
+runCached(
+    void *context
+) {
+    cached_t const
+        *cached = context;
+
+    if (cla_parseCached(cached->schema, cached->cache, cached->result, cached->argc, cached->argv))
+        fprintf(stderr, "clarum_bench: unexpected parse failure\n"), exit(EXIT_FAILURE);
+}
+
+/* Compares parsing repeated command line to restoring it from result cache. */
+static void
+benchmarkCache(
+    settings_t const *settings
+) {
+    uint64_t const
+        *numbersOfArguments = settings->numbersOfArguments.items;
+    cla_option_t
+        options[] = benchmark_options;
+    cla_slot_t
+        slots[cla_numberOfSlots(benchmark_numberOfOptions)];
+    cla_schema_t
+        schema = {
+            .options = options,
+            .numberOfOptions = benchmark_numberOfOptions,
+            .slots = slots,
+            .numberOfSlots = sizeof slots / sizeof *slots,
+        };
+    char
+        *arguments[benchmark_numberOfOptions];
+    uint64_t
+        references[cla_numberOfWords(benchmark_numberOfOptions)],
+        storage[64][32];
+    cla_cache_t
+        cache = {
+            .storage = storage,
+            .numberOfEntries = sizeof storage / sizeof *storage,
+            .entrySize = sizeof *storage,
+        };
+    cla_result_t
+        result = {
+            .arguments = arguments,
+            .references = references,
+        };
+    values_t
+        values;
+
+    options[benchmark_jobs].valuePtr = &values.jobs;
+    options[benchmark_jobs].valueSize = sizeof values.jobs;
+    options[benchmark_verbose].valuePtr = &values.isVerbose;
+    options[benchmark_verbose].valueSize = sizeof values.isVerbose;
+    options[benchmark_quiet].valuePtr = &values.isQuiet;
+    options[benchmark_quiet].valueSize = sizeof values.isQuiet;
+    options[benchmark_output].valuePtr = &values.output;
+    options[benchmark_input].valuePtr = &values.input;
+    options[benchmark_timeout].valuePtr = &values.timeout;
+    options[benchmark_timeout].valueSize = sizeof values.timeout;
+    options[benchmark_bufferSize].valuePtr = &values.bufferSize;
+    options[benchmark_bufferSize].valueSize = sizeof values.bufferSize;
+
+    if (cla_compileSchema(&schema) || cla_getCacheEntrySize(&schema) > cache.entrySize)
+        fprintf(stderr, "clarum_bench: cannot compile schema\n"), exit(EXIT_FAILURE);
+
+    for (size_t i = 0; i < settings->numbersOfArguments.numberOfItems; ++i) {
+        size_t const
+            numberOfArguments = numbersOfArguments[i];
+        char
+            **argv = calloc(numberOfArguments + 1, sizeof *argv);
+        cached_t
+            cached = {
+                .schema = &schema,
+                .cache = &cache,
+                .result = &result,
+                .argc = (int) numberOfArguments + 1,
+                .argv = argv,
+            };
+        double
+            uncachedDuration,
+            cachedDuration;
+
+        if (!numberOfArguments || !argv)
+            fprintf(stderr, "clarum_bench: cannot build %zu arguments\n", numberOfArguments), exit(EXIT_FAILURE);
+
+        argv[0] = "binary";
+        for (size_t j = 1; j <= numberOfArguments; ++j)
+            argv[j] = (char *) vocabulary[getRandomNumber() % (sizeof vocabulary / sizeof *vocabulary)];
+
+        uncachedDuration = measure(settings, &runUncached, &cached);
+        cachedDuration = measure(settings, &runCached, &cached);
+
+        printf("{\"benchmark\": \"cache\", \"arguments\": %zu, \"parse_ns\": %.2f, \"hit_ns\": %.2f, "
+            "\"hits\": %llu, \"misses\": %llu}\n",
+            numberOfArguments, uncachedDuration, cachedDuration,
+            (unsigned long long) cache.numberOfHits, (unsigned long long) cache.numberOfMisses);
+
+        free(argv);
+    }
+}
+
+typedef struct {
+    schema_t const *schema;
+    cla_result_t *result;
+    char **argv;
+} suggestion_t;
+
+static void
+runSuggestion(
+    void *context
+) {
+    suggestion_t const
+        *suggestion = context;
+
+    if (cla_parse(&suggestion->schema->schema, suggestion->result, 2, suggestion->argv) != cla_unknowOptionError)
+        fprintf(stderr, "clarum_bench: unknown option was accepted\n"), exit(EXIT_FAILURE);
+}
+
+/* Measures failed parse of misspelled option, including search for suggestions. */
+static void
+benchmarkSuggestion(
+    settings_t const *settings
+) {
+    uint64_t const
+        *numbersOfOptions = settings->numbersOfOptions.items;
+
+    for (size_t i = 0; i < settings->numbersOfOptions.numberOfItems; ++i) {
+        size_t const
+            numberOfOptions = numbersOfOptions[i];
+        char
+            **values = calloc(numberOfOptions, sizeof *values),
+            misspelled[32],
+            *argv[] = {"binary", misspelled};
+        uint64_t
+            *references = calloc(cla_numberOfWords(numberOfOptions), sizeof *references);
+        cla_diagnostic_t
+            diagnostic;
+        cla_result_t
+            result = {
+                .arguments = values,
+                .references = references,
+                .diagnostic = &diagnostic,
+            };
+        schema_t
+            schema;
+
+        if (!numberOfOptions || !values || !references || !makeSchema(&schema, numberOfOptions))
+            fprintf(stderr, "clarum_bench: cannot build schema of %zu options\n", numberOfOptions), exit(EXIT_FAILURE);
+
+        /* Last option name with its last digit mistyped. */
+        snprintf(misspelled, sizeof misspelled, "--o%zu", numberOfOptions - 1);
+        misspelled[strlen(misspelled) - 1] = 'x';
+
+        {
+            suggestion_t
+                suggestion = {
+                    .schema = &schema,
+                    .result = &result,
+                    .argv = argv,
+                };
+            double const
+                duration = measure(settings, &runSuggestion, &suggestion);
+
+            printf("{\"benchmark\": \"suggest\", \"options\": %zu, \"suggestions\": %zu, \"ns\": %.2f}\n",
+                numberOfOptions, diagnostic.numberOfSuggestions, duration);
+        }
+
+        free(values);
+        free(references);
+        freeSchema(&schema);
+    }
+}
+
+typedef struct {
+    cla_schema_t *schema;
+    void const *image;
+    size_t size;
+} startup_t;
+
+static void
+runCompile(
+    void *context
+) {
+    startup_t const
+        *startup = context;
+
+    if (cla_compileSchema(startup->schema))
+        fprintf(stderr, "clarum_bench: unexpected compile failure\n"), exit(EXIT_FAILURE);
+}
+
+static void
+runLoad(
+    void *context
+) {
+    startup_t const
+        *startup = context;
+
+    if (cla_loadSchema(startup->schema, startup->image, startup->size))
+        fprintf(stderr, "clarum_bench: unexpected load failure\n"), exit(EXIT_FAILURE);
+}
+
+/* Compares compiling schema index on startup to loading its image. */
+static void
+benchmarkStartup(
+    settings_t const *settings
+) {
+    uint64_t const
+        *numbersOfOptions = settings->numbersOfOptions.items;
+
+    for (size_t i = 0; i < settings->numbersOfOptions.numberOfItems; ++i) {
+        size_t const
+            numberOfOptions = numbersOfOptions[i];
+        schema_t
+            schema;
+        cla_schema_t
+            loaded;
+        size_t
+            size;
+        void
+            *image;
+
+        if (!makeSchema(&schema, numberOfOptions))
+            fprintf(stderr, "clarum_bench: cannot build schema of %zu options\n", numberOfOptions), exit(EXIT_FAILURE);
+
+        size = cla_getSchemaImageSize(&schema.schema);
+        image = malloc(size);
+        loaded = (cla_schema_t) {
+            .options = schema.options,
+            .numberOfOptions = numberOfOptions,
+        };
+
+        if (!image || cla_saveSchema(&schema.schema, image, size))
+            fprintf(stderr, "clarum_bench: cannot save schema of %zu options\n", numberOfOptions), exit(EXIT_FAILURE);
+
+        {
+            startup_t
+                compiling = {
+                    .schema = &schema.schema,
+                },
+                loading = {
+                    .schema = &loaded,
+                    .image = image,
+                    .size = size,
+                };
+            double const
+                compileDuration = measure(settings, &runCompile, &compiling),
+                loadDuration = measure(settings, &runLoad, &loading);
+
+            printf("{\"benchmark\": \"startup\", \"method\": \"compile\", \"options\": %zu, \"ns\": %.2f}\n",
+                numberOfOptions, compileDuration);
+            printf("{\"benchmark\": \"startup\", \"method\": \"load\", \"options\": %zu, \"ns\": %.2f}\n",
+                numberOfOptions, loadDuration);
+        }
+
+        free(image);
+        freeSchema(&schema);
+    }
+}
+
+typedef struct {
+    char const *name;
+    cla_handler_t *handler;
+    void const *context;
+    /* Fills @buffer with argument number @index. */
+    void (*makeValue)(char *buffer, size_t size, size_t index);
+    /* Decodes via C library instead of handler when set. */
+    void (*decode)(char const *str, void *value);
+} handler_t;
+
+typedef struct {
+    handler_t const *handler;
+    char (*values)[32];
+    size_t *lengths;
+    union {
+        size_t integer;
+        bool boolean;
+        char *string;
+        double real;
+        float single;
+        int choice;
+        unsigned long long wide;
+    } value;
+} throughput_t;
+
+static void
+makeInteger(
+    char *buffer,
+    size_t size,
+    size_t index
+) {
+    (void) index;
+    snprintf(buffer, size, "%u", (unsigned) (getRandomNumber() % 1000000000));
+}
+
+static void
+makeBoolean(
+    char *buffer,
+    size_t size,
+    size_t index
+) {
+    static char const
+        *const keywords[] = {"true", "yes", "on", "1", "false", "no", "off", "0"};
+
+    snprintf(buffer, size, "%s", keywords[index % 8]);
+}
+
+static void
+makeString(
+    char *buffer,
+    size_t size,
+    size_t index
+) {
+    snprintf(buffer, size, "value-%zu", index);
+}
+
+static void
+makeReal(
+    char *buffer,
+    size_t size,
+    size_t index
+) {
+    uint64_t const
+        bits = getRandomNumber() >> 2;
+    double
+        value;
+
+    /* Alternates exact shortest representations and short decimal values. */
+    memcpy(&value, &bits, sizeof value);
+
+    if (index % 2)
+        snprintf(buffer, size, "%.17g", value);
+    else
+        snprintf(buffer, size, "%u.%02u", (unsigned) (getRandomNumber() % 100000), (unsigned) (index % 100));
+}
+
+static void
+makeChoice(
+    char *buffer,
+    size_t size,
+    size_t index
+) {
+    static char const
+        *const keywords[] = {"none", "fast", "balanced", "small", "smallest"};
+
+    snprintf(buffer, size, "%s", keywords[index % 5]);
+}
+
+static void
+decodeWithStrtod(
+    char const *str,
+    void *value
+) {
+    *((double *) value) = strtod(str, NULL);
+}
+
+static void
+decodeWithStrtoull(
+    char const *str,
+    void *value
+) {
+    *((unsigned long long *) value) = strtoull(str, NULL, 10);
+}
+
+static void
+runHandler(
+    void *context
+) {
+    throughput_t
+        *throughput = context;
+    handler_t const
+        *handler = throughput->handler;
+
+    for (size_t i = 0; i < numberOfValues; ++i) {
+        cla_option_t
+            option = {
+                .argument = throughput->values[i],
+                .argumentLength = throughput->lengths[i],
+                .valuePtr = &throughput->value,
+                .context = handler->context,
+            };
+
+        if (handler->decode)
+            handler->decode(option.argument, option.valuePtr);
+        else if (handler->handler(NULL, &option))
+            fprintf(stderr, "clarum_bench: unexpected handler failure\n"), exit(EXIT_FAILURE);
+    }
+}
+
+static void
+benchmarkHandlers(
+    settings_t const *settings
+) {
+    static cla_keyword_t const
+        keywords[] = {
+            {"none", 0}, {"fast", 1}, {"balanced", 2}, {"small", 3}, {"smallest", 4},
+        };
+    static cla_choice_t
+        choice = {
+            .keywords = keywords,
+            .numberOfKeywords = sizeof keywords / sizeof *keywords,
+        };
+    handler_t const
+        handlers[] = {
+            {"integer", &cla_integerHandler, NULL, &makeInteger, NULL},
+            {"strtoull", NULL, NULL, &makeInteger, &decodeWithStrtoull},
+            {"boolean", &cla_booleanHandler, NULL, &makeBoolean, NULL},
+            {"choice", &cla_choiceHandler, &choice, &makeChoice, NULL},
+            {"string", &cla_stringHandler, NULL, &makeString, NULL},
+            {"double", &cla_doubleHandler, NULL, &makeReal, NULL},
+            {"float", &cla_floatHandler, NULL, &makeReal, NULL},
+            {"strtod", NULL, NULL, &makeReal, &decodeWithStrtod},
+        };
+    static char
+        values[numberOfValues][32];
+    static size_t
+        lengths[numberOfValues];
+
+    if (cla_compileChoice(&choice))
+        fprintf(stderr, "clarum_bench: cannot compile choice\n"), exit(EXIT_FAILURE);
+
+    for (size_t i = 0; i < sizeof handlers / sizeof *handlers; ++i) {
+        throughput_t
+            throughput = {
+                .handler = &handlers[i],
+                .values = values,
+                .lengths = lengths,
+            };
+        size_t
+            numberOfBytes = 0;
+        double
+            duration;
+
+        for (size_t j = 0; j < numberOfValues; ++j) {
+            handlers[i].makeValue(values[j], sizeof values[j], j);
+            lengths[j] = strlen(values[j]);
+            numberOfBytes += lengths[j];
+        }
+
+        duration = measure(settings, &runHandler, &throughput);
+        printf("{\"benchmark\": \"handler\", \"handler\": \"%s\", \"ns_per_value\": %.2f, "
+            "\"values_per_second\": %.0f, \"megabytes_per_second\": %.1f}\n",
+            handlers[i].name, duration / numberOfValues,
+            numberOfValues / duration * 1e9, (double) numberOfBytes / duration * 1e3);
+    }
+}
+
+typedef struct {
+    schema_t const *schema;
+    cla_invocation_t *invocations;
+    cla_result_t *results;
+    size_t numberOfInvocations;
+    size_t numberOfThreads;
+} batch_t;
+
+static void
+runBatch(
+    void *context
+) {
+    batch_t const
+        *batch = context;
+
+    if (cla_parseBatch(&batch->schema->schema, batch->invocations, batch->results,
+        batch->numberOfInvocations, batch->numberOfThreads))
+        fprintf(stderr, "clarum_bench: unexpected batch failure\n"), exit(EXIT_FAILURE);
+}
+
+static void
+benchmarkBatch(
+    settings_t const *settings
+) {
+    enum {
+        numberOfOptions = 100,
+        numberOfInvocations = 4096,
+        numberOfArguments = 16,
+    };
+    static cla_invocation_t
+        invocations[numberOfInvocations];
+    static cla_result_t
+        results[numberOfInvocations];
+    static arguments_t
+        arguments[numberOfInvocations];
+    static char
+        *values[numberOfInvocations][numberOfOptions];
+    static uint64_t
+        references[numberOfInvocations][cla_numberOfWords(numberOfOptions)];
+    schema_t
+        schema;
+    double
+        singleThreadDuration = 0;
+
+    if (!makeSchema(&schema, numberOfOptions))
+        fprintf(stderr, "clarum_bench: cannot build schema\n"), exit(EXIT_FAILURE);
+
+    for (size_t i = 0; i < numberOfInvocations; ++i) {
+        if (!makeArguments(&arguments[i], numberOfOptions, numberOfArguments))
+            fprintf(stderr, "clarum_bench: cannot build arguments\n"), exit(EXIT_FAILURE);
+
+        invocations[i] = (cla_invocation_t) {
+            .argc = arguments[i].argc,
+            .argv = arguments[i].argv,
+        };
+        results[i] = (cla_result_t) {
+            .arguments = values[i],
+            .references = references[i],
+        };
+    }
+
+    for (size_t numberOfThreads = 1; numberOfThreads <= settings->maximumNumberOfThreads; numberOfThreads *= 2) {
+        batch_t
+            batch = {
+                .schema = &schema,
+                .invocations = invocations,
+                .results = results,
+                .numberOfInvocations = numberOfInvocations,
+                .numberOfThreads = numberOfThreads,
+            };
+        double const
+            duration = measure(settings, &runBatch, &batch);
+
+        if (numberOfThreads == 1)
+            singleThreadDuration = duration;
+
+        printf("{\"benchmark\": \"batch\", \"threads\": %zu, \"invocations\": %d, \"arguments\": %d, "
+            "\"ns_per_invocation\": %.2f, \"speedup\": %.2f}\n",
+            numberOfThreads, numberOfInvocations, numberOfArguments,
+            duration / numberOfInvocations, singleThreadDuration / duration);
+    }
+
+    for (size_t i = 0; i < numberOfInvocations; ++i)
+        freeArguments(&arguments[i]);
+
+    freeSchema(&schema);
+}
+
+int
+main(int argc, char **argv) {
+    uint64_t const
+        defaultNumbersOfOptions[] = {10, 100, 1000, 10000},
+        defaultNumbersOfArguments[] = {1, 100, 10000, 100000};
+    long const
+        numberOfProcessors = sysconf(_SC_NPROCESSORS_ONLN);
+    _Alignas(16) char
+        buffer[1024];
+    char
+        *arguments[7];
+    uint64_t
+        references[cla_numberOfWords(7)],
+        duration = 100000000;
+    size_t
+        repetitions = 3,
+        maximumNumberOfThreads = numberOfProcessors > 1 ? (size_t) numberOfProcessors : 1;
+    char
+        *filter = NULL;
+    cla_list_t
+        numbersOfOptions = {
+            .separator = ',',
+        },
+        numbersOfArguments = {
+            .separator = ',',
+        };
+    cla_option_t
+        options[] = {
+            /* --filter=parse runs only benchmarks whose name contains 'parse'. */
+            { .name = "filter", .handler = &cla_stringHandler, .valuePtr = &filter, },
+            /* --duration=250ms sets minimum duration of each repetition. */
+            { .name = "duration", .handler = &cla_durationHandler, .valuePtr = &duration, },
+            { .name = "repetitions", .handler = &cla_integerHandler, .valuePtr = &repetitions, },
+            { .name = "threads", .handler = &cla_integerHandler, .valuePtr = &maximumNumberOfThreads, },
+            /* --options=10,1000 and --arguments=100 override synthetic sizes. */
+            { .name = "options", .handler = &cla_uint64ListHandler, .valuePtr = &numbersOfOptions, },
+            { .name = "arguments", .handler = &cla_uint64ListHandler, .valuePtr = &numbersOfArguments, },
+            { .tag = 'h', .name = "help", .isTerminal = true, },
+        };
+    cla_slot_t
+        slots[cla_numberOfSlots(sizeof options / sizeof *options)];
+    cla_schema_t
+        schema = {
+            .options = options,
+            .numberOfOptions = sizeof options / sizeof *options,
+            .slots = slots,
+            .numberOfSlots = sizeof slots / sizeof *slots,
+        };
+    cla_result_t
+        result = {
+            .arguments = arguments,
+            .references = references,
+            .arena = {
+                .buffer = buffer,
+                .bufferSize = sizeof buffer,
+            },
+        };
+    settings_t
+        settings;
+
+    if (cla_compileSchema(&schema) || cla_parse(&schema, &result, argc, argv) || result.next ||
+        cla_isReferenced(&result, 6) || !repetitions || !maximumNumberOfThreads) {
+        fprintf(stderr, "usage: clarum_bench [--filter=parse|generated|startup|cache|suggest|handler|batch] [--duration=100ms] [--repetitions=3]\n"
+            "                    [--threads=N] [--options=10,100,...] [--arguments=1,100,...]\n");
+        return cla_isReferenced(&result, 6) ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
+    settings = (settings_t) {
+        .filter = filter,
+        .duration = duration,
+        .repetitions = repetitions,
+        .maximumNumberOfThreads = maximumNumberOfThreads,
+        .numbersOfOptions = numbersOfOptions.numberOfItems
+            ? numbersOfOptions
+            : (cla_list_t) {.items = (void *) defaultNumbersOfOptions, .numberOfItems = 4},
+        .numbersOfArguments = numbersOfArguments.numberOfItems
+            ? numbersOfArguments
+            : (cla_list_t) {.items = (void *) defaultNumbersOfArguments, .numberOfItems = 4},
+    };
+
+    if (isSelected(&settings, "parse"))
+        benchmarkParse(&settings);
+
+    if (isSelected(&settings, "generated"))
+        benchmarkGenerated(&settings);
+
+    if (isSelected(&settings, "startup"))
+        benchmarkStartup(&settings);
+
+    if (isSelected(&settings, "cache"))
+        benchmarkCache(&settings);
+
+    if (isSelected(&settings, "suggest"))
+        benchmarkSuggestion(&settings);
+
+    if (isSelected(&settings, "handler"))
+        benchmarkHandlers(&settings);
+
+    if (isSelected(&settings, "batch"))
+        benchmarkBatch(&settings);
+
+    cla_releaseResult(&result);
+    return EXIT_SUCCESS;
+}
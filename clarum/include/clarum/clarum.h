@@ -2,6 +2,7 @@
 
 #include <stddef.h>
 #include <stdbool.h>
+#include <stdint.h>
 
 #if defined(__cplusplus)
 extern "C" {
@@ -15,14 +16,111 @@ typedef
     struct cla_option_t
     cla_option_t;
 
+typedef
+    struct cla_schema_t
+    cla_schema_t;
+
+typedef
+    struct cla_slot_t
+    cla_slot_t;
+
+typedef
+    struct cla_result_t
+    cla_result_t;
+
+typedef
+    struct cla_invocation_t
+    cla_invocation_t;
+
+typedef
+    struct cla_mapping_t
+    cla_mapping_t;
+
+typedef
+    struct cla_stream_t
+    cla_stream_t;
+
+typedef
+    struct cla_keyword_t
+    cla_keyword_t;
+
+typedef
+    struct cla_choice_t
+    cla_choice_t;
+
+typedef
+    struct cla_slice_t
+    cla_slice_t;
+
+typedef
+    struct cla_list_t
+    cla_list_t;
+
+typedef
+    struct cla_arena_t
+    cla_arena_t;
+
+typedef
+    struct cla_token_t
+    cla_token_t;
+
+typedef
+    struct cla_cache_t
+    cla_cache_t;
+
+typedef
+    struct cla_diagnostic_t
+    cla_diagnostic_t;
+
+typedef
+    struct cla_command_t
+    cla_command_t;
+
+typedef
+    struct cla_dispatcher_t
+    cla_dispatcher_t;
+
+#if defined(CLARUM_STATISTICS)
+typedef
+    struct cla_statistics_t
+    cla_statistics_t;
+
+typedef
+    struct cla_event_t
+    cla_event_t;
+#endif
+
 enum {
     cla_noErrors = 0,
     cla_nullReferenceError,
     cla_illegalInputError,
     cla_missingOptionError,
     cla_unknowOptionError,
+    cla_fileError,
+    cla_outOfMemoryError,
+};
+
+/// Origin of option value recorded in cla_result_t::sources.
+enum {
+    /// Value came from command line, or response file.
+    cla_argumentSource = 1,
+
+    /// Value came from environment variable named by cla_option_t::environmentName.
+    cla_environmentSource,
+
+    /// Value came from configuration file named by cla_result_t::configurationPath.
+    cla_fileSource,
 };
 
+/// Version of compiled schema image layout, changed whenever layout or key hashing changes.
+#define cla_schemaImageVersion 1
+
+/// Maximum number of options suggested for unknown option.
+#define cla_maximumNumberOfSuggestions 3
+
+/// Maximum nesting depth of response files.
+#define cla_maximumResponseFileDepth 16
+
 /// Callback type for handling non-built-in types of CLI arguments.
 ///
 /// @details
@@ -31,6 +129,7 @@ enum {
 ///   + NULL in case original argument had no assignment character, e.g. '--opt';
 ///   + empty string in case original argument had empty value, e.g. '--opt=';
 ///   + value of fully-qualified argument, e.g. '--opt=value';
+/// `argumentLength` field is set to number of characters in value,
 /// and `value` field unset.
 /// Use `value` field to store processed result.
 ///
@@ -82,6 +181,38 @@ struct cla_option_t {
 
     /// Is set by parser iff option was encountered.
     bool isReferenced;
+
+    /// Number of characters in option value, set by parser.
+    size_t argumentLength;
+
+    /// Handler-specific data, e.g. cla_choice_t for cla_choiceHandler().
+    void const *context;
+
+    /// Optional name of environment variable providing value when option is not given, e.g. 'TOOL_JOBS'.
+    ///
+    /// @see
+    /// cla_result_t::environment
+    char const *environmentName;
+
+    /// Number of bytes of value holder, letting result cache restore value by copy, e.g. sizeof(size_t).
+    ///
+    /// @details
+    /// Handler of option without size runs again on cache hit,
+    /// which suits values pointing into arguments, e.g. strings.
+    /// Size also lets cla_reparse() reset value of option no longer given.
+    ///
+    /// @see
+    /// cla_parseCached()
+    /// cla_reparse()
+    size_t valueSize;
+
+    /// Specifies whether handler has side effects, or accumulates occurrences.
+    ///
+    /// @details
+    /// Command lines referencing such option are never cached,
+    /// so its handler runs on every occurrence of every parse.
+    /// Options with built-in list handlers are treated so without this flag.
+    bool const hasSideEffects;
 };
 
 /// Represents a context of CLI options parser.
@@ -96,6 +227,23 @@ struct cla_parser_t {
     /// Specifies whether parser should terminate on unknown options.
     bool const isLenient;
 
+    /// Optional compiled index over cla_parser_t::options.
+    ///
+    /// @details
+    /// When set, long and short options are resolved via index
+    /// instead of scanning options one by one.
+    ///
+    /// @see
+    /// cla_compileSchema()
+    cla_schema_t const *schema;
+
+    /// Per-parse state, set only for parsers created by cla_parse().
+    ///
+    /// @details
+    /// When set, parser records references into result instead of options,
+    /// and handlers receive private copy of each option.
+    cla_result_t *result;
+
     /// Is set to first unprocessed option.
     ///
     /// @details
@@ -115,51 +263,1297 @@ struct cla_parser_t {
     bool isTerminated;
 };
 
-/// Parses @p argc and @p argv against collection of options.
+/// Callback type for obtaining and returning arena blocks.
 ///
-/// @param parser
-/// [in, out] Parser instance.
+/// @details
+/// Allocates block of at least @p size bytes when @p block is null,
+/// otherwise frees @p block of @p size bytes previously allocated.
 ///
-/// @param argc
-/// [in] Number of CLI arguments.
+/// @returns
+/// Allocated block, or null when no memory is available or block is freed.
+typedef void *
+cla_allocator_t(
+    void *context,
+    void *block,
+    size_t size
+);
+
+/// Allocator based on malloc() and free(), for arenas which shall grow.
+cla_allocator_t
+cla_heapAllocator;
+
+/// Represents bump-pointer allocator serving all parser-side allocations.
 ///
-/// @param argv
-/// [in] Array of CLI arguments.
+/// @details
+/// Allocates from caller-supplied buffer first, e.g. stack array,
+/// then from blocks obtained via allocator, each twice as large as previous one.
+/// Without allocator, arena never touches heap and fails once buffer is exhausted.
+/// Reset costs constant time unless blocks were grown, which are returned to allocator.
 ///
-/// @returns
-/// Null reference error on null @p options, or @p argv.
-/// Illegal input error on syntax errors.
-int
-cla_parseOptions(
-    cla_parser_t *parser,
-    int argc,
-    char **argv
+/// @see
+/// cla_allocate()
+/// cla_resetArena()
+struct cla_arena_t {
+
+    /// Optional caller-supplied initial block.
+    void *buffer;
+
+    /// Number of bytes in cla_arena_t::buffer.
+    size_t bufferSize;
+
+    /// Optional allocator of further blocks.
+    cla_allocator_t *allocator;
+
+    /// Passed to allocator as is.
+    void *context;
+
+    /// Block being allocated from, set by arena.
+    void *block;
+
+    /// Number of bytes in cla_arena_t::block, set by arena.
+    size_t blockSize;
+
+    /// Number of bytes used in cla_arena_t::block, set by arena.
+    size_t used;
+
+    /// Chain of grown blocks, set by arena.
+    void *blocks;
+};
+
+#if defined(CLARUM_STATISTICS)
+/// Represents counters collected by single parse.
+///
+/// @details
+/// Available only when library is built with CLARUM_STATISTICS;
+/// counters are compiled out otherwise, so parser pays nothing for them.
+/// Reset on every parse, and accumulated over all calls of a stream.
+struct cla_statistics_t {
+
+    /// Number of arguments scanned, including words of response files.
+    size_t numberOfArguments;
+
+    /// Number of options resolved by name or tag.
+    size_t numberOfLookups;
+
+    /// Number of key comparisons made while resolving names.
+    size_t numberOfComparisons;
+
+    /// Number of handler invocations.
+    size_t numberOfHandlerCalls;
+
+    /// Nanoseconds spent in parse, including handlers.
+    uint64_t parseTime;
+
+    /// Nanoseconds spent in handlers.
+    uint64_t handlerTime;
+};
+
+enum {
+    /// Option token was resolved, or found unknown.
+    cla_tokenEvent,
+
+    /// Handler returned.
+    cla_handlerEvent,
+};
+
+/// Describes single step of parse reported to tracer.
+struct cla_event_t {
+
+    /// One of cla_tokenEvent, or cla_handlerEvent.
+    int kind;
+
+    /// Resolved option, or null for unknown option.
+    cla_option_t const *option;
+
+    /// Option name or tag as written, not terminated.
+    char const *name;
+
+    /// Number of characters in cla_event_t::name.
+    size_t nameLength;
+
+    /// Option argument, or null if there is none.
+    char const *argument;
+
+    /// Number of characters in cla_event_t::argument.
+    size_t argumentLength;
+
+    /// Status returned by handler, set for handler events.
+    int status;
+
+    /// Nanoseconds spent in handler, set for handler events.
+    uint64_t duration;
+};
+
+/// Callback type for tracing parse.
+///
+/// @details
+/// Invoked on parser thread, once per option token and once per handler call.
+/// Event and strings it points to are valid only during the call.
+typedef void
+cla_tracer_t(
+    void *context,
+    cla_event_t const *event
 );
+#endif
 
-/// Default callback handler for boolean values.
+/// Represents single argument split at its first '=' delimiter.
+struct cla_token_t {
+
+    /// Points to name, including escape characters, not terminated.
+    char *name;
+
+    /// Number of characters in cla_token_t::name.
+    size_t nameLength;
+
+    /// Points to value past delimiter, or null when there is no delimiter.
+    char *value;
+
+    /// Number of characters in cla_token_t::value.
+    size_t valueLength;
+};
+
+/// Represents single entry of compiled option index.
+struct cla_slot_t {
+    /// Hash of referenced name, synonym, or environment name.
+    uint32_t hash;
+
+    /// Encodes index of referenced option and kind of key, zero for vacant slots.
+    uint32_t entry;
+};
+
+/// Evaluates to number of index slots sufficient for @p numberOfOptions.
 ///
 /// @details
-/// Accepts:
-///   + 'on', 'true', 'yes', and '1' as 'true' values;
-///   + 'off', 'false', 'no', and '0' as 'false' values.
+/// Keeps index load factor at or below one half for names and synonyms,
+/// and at or below three quarters when every option has environment name as well.
+#define cla_numberOfSlots(numberOfOptions) \
+    (4 * (numberOfOptions) + 1)
+
+/// Represents compiled index over collection of options.
 ///
-/// When no value is set, underlying option value is set to 'true'.
+/// @details
+/// Index is built once by cla_compileSchema() and is not modified by parser,
+/// so single schema may serve any number of parsers over the same options.
+struct cla_schema_t {
+
+    /// Array of CLI options.
+    cla_option_t *options;
+
+    /// Number of options.
+    size_t numberOfOptions;
+
+    /// Caller-provided storage for hashed index over names, synonyms, and environment names.
+    cla_slot_t *slots;
+
+    /// Number of slots, at least cla_numberOfSlots(numberOfOptions).
+    size_t numberOfSlots;
+
+    /// Specifies whether parser should terminate on unknown options.
+    bool isLenient;
+
+    /// Number of required options, set by cla_compileSchema().
+    size_t numberOfRequiredOptions;
+
+    /// Number of options with environment name, set by cla_compileSchema().
+    size_t numberOfEnvironmentOptions;
+
+    /// Maps each tag character onto option index plus one, zero for unused tags.
+    uint32_t tags[256];
+};
+
+/// Represents file mapped into memory.
+struct cla_mapping_t {
+
+    /// Points to first byte of mapping.
+    char *address;
+
+    /// Number of bytes in file.
+    size_t size;
+};
+
+/// Describes why last parse failed.
 ///
-/// @returns
-/// Invalid option argument when option argument
-/// does not match any supported value.
-cla_handler_t
-cla_booleanHandler;
+/// @details
+/// Diagnostic points into arguments, environment, or mapped files,
+/// hence it is valid as long as result arguments are.
+struct cla_diagnostic_t {
 
-/// Default callback handler for integer values.
+    /// Origin of offending token, i.e. cla_argumentSource, cla_environmentSource,
+    /// or cla_fileSource, zero when failure is not caused by single token.
+    int source;
+
+    /// Index of offending argument within argv, or buffer, index of environment entry,
+    /// or line number within configuration file, counting from one.
+    ///
+    /// @details
+    /// Token found within response file is reported at index of its '@file' argument.
+    /// Streams do not count arguments, so index is zero.
+    size_t index;
+
+    /// Byte offset of offending token within its argument, response file word, environment entry, or line.
+    size_t offset;
+
+    /// Points to offending token, which need not be terminated: unknown option name,
+    /// value rejected by handler, malformed argument, or path of response file.
+    char const *token;
+
+    /// Number of characters in token.
+    size_t tokenLength;
+
+    /// Option whose handler failed, or first required option which is missing.
+    cla_option_t const *option;
+
+    /// Options named closest to unknown option, closest first.
+    ///
+    /// @details
+    /// Names and synonyms within one edit per four characters of unknown long option, plus one,
+    /// but at most three edits are suggested. They are found by bit-parallel search over
+    /// schema options, which allocates nothing. Unknown option longer than 64 characters
+    /// gets no suggestions, since its characters are held as bits of single word.
+    cla_option_t const *suggestions[cla_maximumNumberOfSuggestions];
+
+    /// Number of entries in cla_diagnostic_t::suggestions.
+    size_t numberOfSuggestions;
+};
+
+/// Evaluates to number of words sufficient to hold one bit per option.
+#define cla_numberOfWords(numberOfOptions) \
+    (((numberOfOptions) + 63) / 64)
+
+/// Represents outcome of single cla_parse() call.
+///
+/// @details
+/// Holds all state which parser would otherwise write into options,
+/// so that compiled schema stays read-only and may be shared between threads.
+/// All storage is provided by caller; result is reset on every parse.
+struct cla_result_t {
+
+    /// Caller-provided storage for argument of each option.
+    ///
+    /// @details
+    /// Holds cla_schema_t::numberOfOptions entries;
+    /// entry is valid iff corresponding option is referenced.
+    char **arguments;
+
+    /// Caller-provided storage for referenced bits.
+    ///
+    /// @details
+    /// Holds cla_numberOfWords(cla_schema_t::numberOfOptions) entries.
+    uint64_t *references;
+
+    /// Optional per-option value holders, overriding cla_option_t::valuePtr.
+    ///
+    /// @details
+    /// Holds cla_schema_t::numberOfOptions entries when set,
+    /// letting concurrent parses decode values into separate storage.
+    void * const *values;
+
+    /// Optional caller-provided storage for argument lengths, enabling lazy decoding.
+    ///
+    /// @details
+    /// Holds cla_schema_t::numberOfOptions entries when set;
+    /// parser then only records argument of each referenced option
+    /// and runs no handlers, while referenced and required options
+    /// are still checked up front. Values are decoded by cla_get().
+    ///
+    /// @see
+    /// cla_get()
+    size_t *argumentLengths;
+
+    /// Caller-provided storage for decoded bits, required along with cla_result_t::argumentLengths.
+    ///
+    /// @details
+    /// Holds cla_numberOfWords(cla_schema_t::numberOfOptions) entries.
+    uint64_t *decodedOptions;
+
+    /// Schema of last parse, set by parser.
+    cla_schema_t const *schema;
+
+    /// Number of distinct required options referenced, set by parser.
+    size_t numberOfRequiredReferences;
+
+    /// Status of last parse, as returned by cla_parse().
+    int status;
+
+    /// Optional caller-provided storage for response files and configuration file mapped during parse.
+    ///
+    /// @details
+    /// Response files are expanded only when storage is set;
+    /// arguments point directly into mappings, which stay alive
+    /// until result is released or reused.
+    ///
+    /// @see
+    /// cla_releaseResult()
+    cla_mapping_t *mappings;
+
+    /// Number of entries in cla_result_t::mappings.
+    size_t maximumNumberOfMappings;
+
+    /// Number of response files mapped, set by parser.
+    size_t numberOfMappings;
+
+    /// Arena holding list items and other values allocated during parse.
+    ///
+    /// @details
+    /// Arena is reset on every parse, so its storage is reused.
+    ///
+    /// @see
+    /// cla_listHandler()
+    cla_arena_t arena;
+
+    /// Lists filled during last parse, chained via cla_list_t::next.
+    cla_list_t *lists;
+
+    /// Optional environment, e.g. environ, providing values of options not given on command line.
+    ///
+    /// @details
+    /// Null-terminated array of 'NAME=value' entries, scanned once per parse
+    /// after command line; each name is resolved via schema index,
+    /// so cost does not depend on number of options. Handlers run
+    /// as if values came from command line, and arguments point into entries.
+    /// Environment is not consulted when parse fails, or is terminated.
+    ///
+    /// @see
+    /// cla_option_t::environmentName
+    char **environment;
+
+    /// Optional path of configuration file providing values of options given neither on command line, nor in environment.
+    ///
+    /// @details
+    /// File holds 'key = value' lines, where key is option name or synonym;
+    /// key without value references flag option, e.g. 'verbose'.
+    /// Blank lines, lines starting with '#' or ';', and '[section]' headers are skipped,
+    /// and quotes around value preserve its surrounding blanks.
+    /// File is mapped into cla_result_t::mappings and split in place, so arguments
+    /// point into mapping; unknown keys are rejected unless schema is lenient,
+    /// and the first setting of repeated key wins.
+    /// File is not consulted when parse fails, or is terminated.
+    char const *configurationPath;
+
+    /// Optional caller-provided storage for origin of each option value.
+    ///
+    /// @details
+    /// Holds cla_schema_t::numberOfOptions entries when set;
+    /// entry is set to cla_argumentSource, cla_environmentSource, or cla_fileSource
+    /// iff corresponding option is referenced.
+    unsigned char *sources;
+
+    /// Optional caller-provided storage for diagnostic of failed parse, reset on every parse.
+    cla_diagnostic_t *diagnostic;
+
+    /// Is set to first unprocessed option.
+    char const *next;
+
+    /// Is set iff parser was terminated during parsing.
+    ///
+    /// @see
+    /// cla_parser_t::isTerminated
+    bool isTerminated;
+
+#if defined(CLARUM_STATISTICS)
+    /// Counters of last parse, set by parser.
+    cla_statistics_t statistics;
+
+    /// Optional callback receiving parse events.
+    cla_tracer_t *tracer;
+
+    /// Passed to tracer as is.
+    void *tracerContext;
+#endif
+};
+
+/// Builds hashed index over names, synonyms and environment names, and tag table of schema options.
 ///
 /// @details
-/// Employs ct_parseIntegerFromDecimalString() behind the scenes.
+/// Index resolves long options with exact (length-aware) comparison
+/// in constant expected time, regardless of number of options;
+/// tag table resolves each short option with a single load.
+///
+/// @param schema
+/// [in, out] Schema with options and slots set.
 ///
 /// @returns
-/// Invalid option argument error when option argument is not set.
-cla_handler_t
-cla_integerHandler;
+/// Null reference error on null @p schema, its options, or slots.
+///
+/// @returns
+/// Illegal input error on insufficient number of slots,
+/// or when tags, names and synonyms, or environment names are not unique.
+int
+cla_compileSchema(
+    cla_schema_t *schema
+);
+
+/// Computes number of bytes of image serialized from @p schema by cla_saveSchema().
+///
+/// @param schema
+/// [in] Compiled schema.
+///
+/// @returns
+/// Zero on null @p schema.
+size_t
+cla_getSchemaImageSize(
+    cla_schema_t const *schema
+);
+
+/// Serializes index of compiled schema into position-independent image.
+///
+/// @details
+/// Image holds no pointers, only slots, tag table and counters,
+/// along with fingerprint of names, synonyms, environment names, tags
+/// and required flags of schema options, so it may be written to file,
+/// or emitted at build time as constant data (see clarum_generate_parser()).
+/// Image uses byte order of writing machine, which is checked on load.
+///
+/// @param schema
+/// [in] Compiled schema.
+///
+/// @param image
+/// [out] Storage for image, aligned to 8 bytes.
+///
+/// @param size
+/// [in] Number of bytes in @p image, at least cla_getSchemaImageSize().
+///
+/// @returns
+/// Null reference error on null @p schema, its options, slots, or @p image.
+/// Illegal input error on misaligned @p image.
+/// Out of memory error when @p image is too small.
+int
+cla_saveSchema(
+    cla_schema_t const *schema,
+    void *image,
+    size_t size
+);
+
+/// Makes @p schema use index serialized by cla_saveSchema(), without compiling it.
+///
+/// @details
+/// Slots are used in place, so loading costs one pass over option keys
+/// to check fingerprint, plus copy of tag table, and allocates nothing.
+/// Image may be mapped from file, or be constant data,
+/// and shall outlive every parse with @p schema.
+///
+/// @warning
+/// Slots of loaded schema point into @p image, hence schema shall not be compiled again.
+/// Image is trusted as code is: fingerprint catches stale images, not forged ones.
+///
+/// @param schema
+/// [in, out] Schema with options set, receiving slots and tag table.
+///
+/// @param image
+/// [in] Image aligned to 8 bytes.
+///
+/// @param size
+/// [in] Number of bytes in @p image.
+///
+/// @returns
+/// Null reference error on null @p schema, its options, or @p image.
+/// Illegal input error on misaligned, truncated, or foreign image,
+/// image of another version, or image built from different options.
+int
+cla_loadSchema(
+    cla_schema_t *schema,
+    void const *image,
+    size_t size
+);
+
+/// Parses @p argc and @p argv against collection of options.
+///
+/// @param parser
+/// [in, out] Parser instance.
+///
+/// @param argc
+/// [in] Number of CLI arguments.
+///
+/// @param argv
+/// [in] Array of CLI arguments.
+///
+/// @returns
+/// Null reference error on null @p options, or @p argv.
+/// Illegal input error on syntax errors.
+int
+cla_parseOptions(
+    cla_parser_t *parser,
+    int argc,
+    char **argv
+);
+
+/// Parses @p argc and @p argv against compiled schema into separate result.
+///
+/// @details
+/// Neither @p schema nor its options are modified, hence single schema
+/// may be used by any number of threads concurrently without locking,
+/// given that each one supplies its own @p result.
+///
+/// Arguments of '@path' form are replaced by contents of response file at path,
+/// when @p result has mapping storage set. Response file is split in place
+/// on whitespace, honouring single quotes, double quotes and backslash escapes,
+/// and may reference other response files up to cla_maximumResponseFileDepth.
+///
+/// @param schema
+/// [in] Compiled schema.
+///
+/// @param result
+/// [in, out] Result with storage set.
+///
+/// @param argc
+/// [in] Number of CLI arguments.
+///
+/// @param argv
+/// [in] Array of CLI arguments.
+///
+/// @returns
+/// Null reference error on null @p schema, @p result, its storage, or @p argv.
+/// Illegal input error on syntax errors, or too deeply nested response files.
+/// Missing option error when any required option is not referenced.
+/// File error when response file cannot be mapped.
+/// Out of memory error when mapping storage is exhausted.
+int
+cla_parse(
+    cla_schema_t const *schema,
+    cla_result_t *result,
+    int argc,
+    char **argv
+);
+
+/// Parses NUL-separated @p buffer against compiled schema into separate result.
+///
+/// @details
+/// Walks buffer in place, e.g. contents of '/proc/<pid>/cmdline',
+/// where first argument is binary name, without building argv.
+/// Last argument need not be terminated, in which case it is copied
+/// into cla_result_t::arena along with terminator, so that handlers,
+/// lazy values, and cla_result_t::next see terminated string.
+///
+/// @warning
+/// Other arguments point into @p buffer, which handlers shall not modify.
+///
+/// @param schema
+/// [in] Compiled schema.
+///
+/// @param result
+/// [in, out] Result with storage set.
+///
+/// @param buffer
+/// [in] NUL-separated arguments.
+///
+/// @param length
+/// [in] Number of bytes in @p buffer.
+///
+/// @returns
+/// Same as cla_parse().
+/// Out of memory error when unterminated last argument does not fit result arena.
+int
+cla_parseBuffer(
+    cla_schema_t const *schema,
+    cla_result_t *result,
+    char const *buffer,
+    size_t length
+);
+
+/// Represents state of incremental parsing of argument stream.
+///
+/// @details
+/// Arguments arrive in chunks of arbitrary size (see cla_feed()),
+/// each one is parsed and handled as soon as its separator arrives.
+/// Arguments which span chunks are assembled in caller-provided buffer,
+/// so memory use is bounded by the longest argument.
+///
+/// @warning
+/// Arguments, including cla_result_t::arguments and cla_result_t::next,
+/// are only valid during the call which parsed them, as chunks
+/// and assembly buffer are reused; handlers shall copy values they keep.
+struct cla_stream_t {
+
+    /// Compiled schema.
+    cla_schema_t const *schema;
+
+    /// Result with storage set.
+    cla_result_t *result;
+
+    /// Caller-provided storage for arguments which span chunks.
+    char *buffer;
+
+    /// Number of bytes in cla_stream_t::buffer.
+    size_t bufferSize;
+
+    /// Character which separates arguments, NUL by default.
+    char separator;
+
+    /// Number of bytes of pending argument in buffer, set by parser.
+    size_t length;
+
+    /// Status of parsing, set by parser; parsing stops on first error.
+    int status;
+};
+
+/// Starts incremental parsing, resetting @p stream and its result.
+///
+/// @returns
+/// Null reference error on null @p stream, its schema, result, or result storage.
+/// Illegal input error on lazy result, as arguments do not outlive the calls which parse them.
+int
+cla_beginStream(
+    cla_stream_t *stream
+);
+
+/// Parses every argument completed by @p chunk.
+///
+/// @details
+/// Unlike cla_parse(), stream has no binary name,
+/// so its first argument is parsed as well.
+/// Arguments which follow terminal option or first operand are skipped.
+///
+/// @param stream
+/// [in, out] Stream started by cla_beginStream().
+///
+/// @param chunk
+/// [in] Next bytes of stream.
+///
+/// @param length
+/// [in] Number of bytes in @p chunk.
+///
+/// @returns
+/// Same as cla_parse(), except for missing option error (see cla_finish()).
+/// Out of memory error when argument does not fit stream buffer.
+int
+cla_feed(
+    cla_stream_t *stream,
+    char const *chunk,
+    size_t length
+);
+
+/// Parses pending argument, if any, and completes parsing.
+///
+/// @returns
+/// Same as cla_parse().
+int
+cla_finish(
+    cla_stream_t *stream
+);
+
+/// Represents single command line of a batch.
+struct cla_invocation_t {
+
+    /// Number of CLI arguments.
+    int argc;
+
+    /// Array of CLI arguments.
+    char **argv;
+};
+
+/// Parses each invocation against compiled schema into corresponding result.
+///
+/// @details
+/// Invocations are split evenly between @p numberOfThreads workers,
+/// including calling thread; workers which run out of invocations
+/// steal remaining ones from others.
+/// Failure of single invocation is reported via cla_result_t::status
+/// and does not affect the rest of the batch.
+/// Library built without threads (see CLARUM_THREADS option)
+/// parses whole batch on calling thread.
+///
+/// @warning
+/// Results which share value holders (see cla_result_t::values)
+/// are decoded concurrently, so each result shall have its own holders
+/// unless options have no handlers.
+///
+/// @param schema
+/// [in] Compiled schema.
+///
+/// @param invocations
+/// [in] Array of command lines.
+///
+/// @param results
+/// [in, out] Array of results with storage set, one per invocation.
+///
+/// @param numberOfInvocations
+/// [in] Number of invocations.
+///
+/// @param numberOfThreads
+/// [in] Number of workers, zero or one parse on calling thread only.
+///
+/// @returns
+/// Null reference error on null @p schema, @p invocations, or @p results.
+int
+cla_parseBatch(
+    cla_schema_t const *schema,
+    cla_invocation_t const *invocations,
+    cla_result_t *results,
+    size_t numberOfInvocations,
+    size_t numberOfThreads
+);
+
+/// Represents table of parse results keyed by hash of command line.
+///
+/// @details
+/// Entries hold no pointers: arguments are recorded as positions within argv,
+/// so storage may be process-local, or shared memory mapping
+/// used by every process parsing with the same schema.
+/// Each entry is guarded by sequence counter, so concurrent parses
+/// never observe torn entries, and writer which loses the race skips storing.
+struct cla_cache_t {
+
+    /// Caller-provided storage for entries, aligned to 8 bytes and zero-filled before first use.
+    void *storage;
+
+    /// Number of entries.
+    size_t numberOfEntries;
+
+    /// Number of bytes of each entry, at least cla_getCacheEntrySize().
+    size_t entrySize;
+
+    /// Number of parses restored from cache, updated atomically.
+    uint64_t numberOfHits;
+
+    /// Number of cacheable parses not found in cache, updated atomically.
+    uint64_t numberOfMisses;
+};
+
+/// Computes number of bytes of cache entry able to hold any result of @p schema.
+///
+/// @param schema
+/// [in] Compiled schema.
+///
+/// @returns
+/// Zero on null @p schema.
+size_t
+cla_getCacheEntrySize(
+    cla_schema_t const *schema
+);
+
+/// Parses @p argc and @p argv as cla_parse() does, restoring result from @p cache when command line was seen before.
+///
+/// @details
+/// Command line is hashed and looked up in @p cache. On hit, referenced bits,
+/// arguments and values of options with cla_option_t::valueSize are restored
+/// without tokenizing, while handlers of options without value size run again.
+/// On miss, result of successful parse is stored, unless command line
+/// references option with side effects, or list option, or expands response files.
+/// Results consulting environment, or configuration file, bypass cache.
+///
+/// @warning
+/// Cache shall only be used with one schema.
+/// Command lines are told apart by 64-bit hash, whose collisions are not detected.
+/// Restored arguments are still checked to lie within current ones.
+///
+/// @param schema
+/// [in] Compiled schema.
+///
+/// @param cache
+/// [in, out] Cache with storage set.
+///
+/// @param result
+/// [in, out] Eager result with storage set.
+///
+/// @param argc
+/// [in] Number of CLI arguments.
+///
+/// @param argv
+/// [in] Array of CLI arguments.
+///
+/// @returns
+/// Null reference error on null @p schema, @p cache, its storage, @p result, or @p argv.
+/// Illegal input error on misaligned storage, entry size below cla_getCacheEntrySize(), or lazy @p result.
+/// Otherwise same as cla_parse().
+int
+cla_parseCached(
+    cla_schema_t const *schema,
+    cla_cache_t *cache,
+    cla_result_t *result,
+    int argc,
+    char **argv
+);
+
+/// Represents subcommand, e.g. 'build' of 'tool build --jobs=4'.
+struct cla_command_t {
+
+    /// Name matched against first operand.
+    char const *name;
+
+    /// Schema of command options with storage set, compiled on first dispatch to command.
+    cla_schema_t *schema;
+
+    /// Is set once schema is compiled, set by dispatcher.
+    ///
+    /// @details
+    /// Caller may set it for schemas compiled in advance.
+    bool isCompiled;
+};
+
+/// Represents collection of subcommands sharing global options.
+///
+/// @details
+/// Command names are indexed once by cla_compileDispatcher(), while schema
+/// of each command is compiled only when command is dispatched to,
+/// so that startup never pays for options of commands which do not run.
+struct cla_dispatcher_t {
+
+    /// Optional compiled schema of global options, which precede command name.
+    cla_schema_t const *globals;
+
+    /// Array of commands.
+    cla_command_t *commands;
+
+    /// Number of commands.
+    size_t numberOfCommands;
+
+    /// Caller-provided storage for hashed index over command names.
+    cla_slot_t *slots;
+
+    /// Number of slots, at least cla_numberOfSlots(numberOfCommands).
+    size_t numberOfSlots;
+};
+
+/// Builds hashed index over command names.
+///
+/// @param dispatcher
+/// [in, out] Dispatcher with commands and slots set.
+///
+/// @returns
+/// Null reference error on null @p dispatcher, its commands, slots, or command schema.
+/// Illegal input error on insufficient number of slots, or empty or duplicate command names.
+int
+cla_compileDispatcher(
+    cla_dispatcher_t *dispatcher
+);
+
+/// Parses global options, then options of command named by first operand.
+///
+/// @details
+/// Global options are parsed into @p globalResult up to first operand,
+/// which selects command in constant expected time. Command schema is compiled
+/// on first dispatch, then arguments following command name are parsed
+/// into @p commandResult, as if command name were binary name.
+/// Terminal global option, e.g. '--help', completes dispatch without command.
+///
+/// @warning
+/// First dispatch to command compiles its schema, so concurrent dispatches
+/// require commands to be compiled in advance.
+///
+/// @param dispatcher
+/// [in] Compiled dispatcher.
+///
+/// @param globalResult
+/// [in, out] Result of global options with storage set, may be null without global options.
+///
+/// @param commandResult
+/// [in, out] Result of command options with storage set.
+///
+/// @param argc
+/// [in] Number of CLI arguments.
+///
+/// @param argv
+/// [in] Array of CLI arguments.
+///
+/// @param command
+/// [out] Selected command, or null when no command was selected.
+///
+/// @returns
+/// Null reference error on null @p dispatcher, its storage, results, @p argv, or @p command.
+/// Missing option error when command name is not given.
+/// Unknown option error when no command has given name.
+/// Illegal input error when command name does not come directly from @p argv.
+/// Otherwise same as cla_parse() of global, then command options.
+int
+cla_dispatch(
+    cla_dispatcher_t const *dispatcher,
+    cla_result_t *globalResult,
+    cla_result_t *commandResult,
+    int argc,
+    char **argv,
+    cla_command_t **command
+);
+
+/// Splits @p argument exactly as parser does, for front ends built over the engine.
+///
+/// @param token
+/// [out] Token pointing into @p argument.
+///
+/// @param argument
+/// [in] Terminated CLI argument.
+void
+cla_tokenize(
+    cla_token_t *token,
+    char *argument
+);
+
+/// Releases response files mapped and lists filled during last parse.
+///
+/// @details
+/// Arguments which point into response files become invalid;
+/// lists are emptied and result arena is reset.
+void
+cla_releaseResult(
+    cla_result_t *result
+);
+
+/// Decodes value of @p option referenced during last parse, unless it is already decoded.
+///
+/// @details
+/// Runs handler of @p option on its recorded argument the first time it is called,
+/// storing value as eager parse would; later calls return at once.
+/// Failed decoding is not memoized. Result which is not lazy was decoded during parse,
+/// so call does nothing, hence code reading values this way works in both modes.
+///
+/// @warning
+/// Lazy result records last occurrence of every option only,
+/// so options accumulating all occurrences, e.g. lists, shall be parsed eagerly.
+///
+/// @param result
+/// [in, out] Result of last parse.
+///
+/// @param option
+/// [in] Option of schema used by last parse.
+///
+/// @returns
+/// Null reference error on null @p result, or @p option, or result which was not parsed.
+/// Illegal input error when @p option does not belong to schema of last parse.
+/// Otherwise status returned by handler, or no errors when option was not referenced.
+int
+cla_get(
+    cla_result_t *result,
+    cla_option_t const *option
+);
+
+/// Parses @p argc and @p argv, then runs handlers only of options whose value differs from @p previous.
+///
+/// @details
+/// Meant for reloads, e.g. on SIGHUP: new arguments, environment and configuration file
+/// are recorded into @p result as lazy parse would, then compared with @p previous
+/// option by option. Handlers run for added and changed options only,
+/// while unchanged options inherit decoded state of @p previous, so reload
+/// costs handler time in proportion to change. Removed options run no handler;
+/// their holders are zero-filled when cla_option_t::valueSize is set,
+/// otherwise their values are left for caller to reset.
+/// Results are meant to be used as double buffer, since arguments of @p previous
+/// shall stay valid during call; @p previous may then be released or reused by the next reload.
+///
+/// @warning
+/// Both results shall share value holders, since unchanged values are not decoded again.
+///
+/// @param schema
+/// [in] Compiled schema.
+///
+/// @param previous
+/// [in] Lazy result of last cla_parse() or cla_reparse() of @p schema,
+/// or null for initial load, when every referenced option counts as added.
+///
+/// @param result
+/// [in, out] Lazy result with storage set, receiving new state.
+///
+/// @param argc
+/// [in] Number of CLI arguments.
+///
+/// @param argv
+/// [in] Array of CLI arguments.
+///
+/// @param changedOptions
+/// [out] Storage for cla_numberOfWords(cla_schema_t::numberOfOptions) words,
+/// receiving bit of every added, changed, or removed option. It is cleared
+/// on any error, hence it is meaningful only when no errors are returned.
+///
+/// @returns
+/// Null reference error on null @p schema, @p result, its storage, @p argv, or @p changedOptions.
+/// Illegal input error when @p result, or @p previous is not lazy, or @p previous was parsed by another schema.
+/// Otherwise same as cla_parse(), or first error returned by handler.
+int
+cla_reparse(
+    cla_schema_t const *schema,
+    cla_result_t const *previous,
+    cla_result_t *result,
+    int argc,
+    char **argv,
+    uint64_t *changedOptions
+);
+
+/// Checks whether option at @p index was referenced during last parse.
+bool
+cla_isReferenced(
+    cla_result_t const *result,
+    size_t index
+);
+
+/// Maximum number of keywords per choice.
+#define cla_maximumNumberOfKeywords 48
+
+/// Maps single keyword onto integer value.
+struct cla_keyword_t {
+
+    /// Keyword, e.g. 'fast'.
+    char const *name;
+
+    /// Value stored on match.
+    int value;
+};
+
+/// Represents compiled set of keywords, e.g. for enum-like options.
+///
+/// @details
+/// Keywords are indexed by cla_compileChoice() into collision-free hash table,
+/// so that any argument is resolved with one hash and one comparison.
+struct cla_choice_t {
+
+    /// Array of keywords.
+    cla_keyword_t const *keywords;
+
+    /// Number of keywords, at most cla_maximumNumberOfKeywords.
+    size_t numberOfKeywords;
+
+    /// Multiplier of keyword hash, set by cla_compileChoice().
+    uint32_t seed;
+
+    /// Number of bits in slot index, set by cla_compileChoice().
+    unsigned numberOfBits;
+
+    /// Maps each slot onto keyword index plus one, zero for vacant slots.
+    uint8_t slots[256];
+};
+
+/// Builds collision-free index over keywords of @p choice.
+///
+/// @param choice
+/// [in, out] Set of keywords to be indexed.
+///
+/// @returns
+/// Null reference error on null @p choice or keyword name.
+///
+/// @returns
+/// Illegal input error on duplicate keywords or too many keywords.
+int
+cla_compileChoice(
+    cla_choice_t *choice
+);
+
+/// Callback handler for keyword values.
+///
+/// @details
+/// Resolves argument against compiled cla_choice_t
+/// passed via cla_option_t::context, and stores value of matching keyword as int.
+///
+/// @returns
+/// Null reference error when option argument, value, or context is not set.
+///
+/// @returns
+/// Illegal input error when argument matches no keyword.
+cla_handler_t
+cla_choiceHandler;
+
+/// Default callback handler for boolean values.
+///
+/// @details
+/// Accepts:
+///   + 'on', 'true', 'yes', and '1' as 'true' values;
+///   + 'off', 'false', 'no', and '0' as 'false' values.
+///
+/// When no value is set, underlying option value is set to 'true'.
+/// Built on cla_choiceHandler() with precompiled keyword set.
+///
+/// @returns
+/// Invalid option argument when option argument
+/// does not match any supported value.
+cla_handler_t
+cla_booleanHandler;
+
+/// Default callback handler for integer values.
+///
+/// @details
+/// Decodes unsigned decimal or '0x'-prefixed hexadecimal argument into size_t.
+/// Decimal digits are decoded eight at a time; overflow is checked exactly,
+/// independent of locale.
+/// Option value is left intact unless argument is decoded.
+///
+/// @returns
+/// Null reference error when option argument or value is not set.
+///
+/// @returns
+/// Illegal input error when argument is malformed or does not fit.
+cla_handler_t
+cla_integerHandler;
+
+/// Callback handler for int32_t values.
+///
+/// @details
+/// Accepts optional '+' or '-' sign, otherwise behaves like cla_integerHandler().
+///
+/// @see cla_integerHandler
+cla_handler_t
+cla_int32Handler;
+
+/// Callback handler for int64_t values.
+///
+/// @see cla_int32Handler
+cla_handler_t
+cla_int64Handler;
+
+/// Callback handler for uint32_t values.
+///
+/// @details
+/// Accepts optional '+' sign, otherwise behaves like cla_integerHandler().
+///
+/// @see cla_integerHandler
+cla_handler_t
+cla_uint32Handler;
+
+/// Callback handler for uint64_t values.
+///
+/// @see cla_uint32Handler
+cla_handler_t
+cla_uint64Handler;
+
+/// Callback handler for sizes in bytes, stored as uint64_t.
+///
+/// @details
+/// Accepts decimal number followed by optional suffix:
+///   + 'B' or none for bytes;
+///   + 'K', 'KiB', 'M', 'MiB', ... 'E', 'EiB' for powers of 1024;
+///   + 'KB', 'MB', ... 'EB' for powers of 1000.
+///
+/// Lowercase 'k' is accepted as well. Hexadecimal values take no suffix.
+///
+/// @see cla_integerHandler
+cla_handler_t
+cla_sizeHandler;
+
+/// Callback handler for durations in nanoseconds, stored as uint64_t.
+///
+/// @details
+/// Accepts decimal number followed by optional suffix:
+/// 'ns', 'us', 'ms', 's', 'm' or 'min', 'h', and 'd'.
+/// Number without suffix is taken as seconds.
+///
+/// @see cla_integerHandler
+cla_handler_t
+cla_durationHandler;
+
+/// Callback handler for double values.
+///
+/// @details
+/// Decodes decimal argument with optional fraction and exponent,
+/// as well as 'inf', 'infinity' and 'nan' in any case.
+/// Rounds correctly to nearest, ties to even, so result matches strtod() in "C" locale,
+/// yet does not depend on current locale.
+/// Mantissas of up to 19 digits are decoded without the C library.
+///
+/// @returns
+/// Null reference error when option argument or value is not set.
+///
+/// @returns
+/// Illegal input error when argument is malformed or overflows to infinity.
+cla_handler_t
+cla_doubleHandler;
+
+/// Callback handler for float values.
+///
+/// @details
+/// Rounds decimal argument directly to float, matching strtof().
+///
+/// @see cla_doubleHandler
+cla_handler_t
+cla_floatHandler;
+
+/// Allocates @p size bytes from @p arena, aligned for any built-in value type.
+///
+/// @details
+/// Handlers may allocate from arena of cla_parser_t::result,
+/// so that their values are released along with result.
+///
+/// @returns
+/// Allocated memory, or null on null @p arena or exhausted arena.
+void *
+cla_allocate(
+    cla_arena_t *arena,
+    size_t size
+);
+
+/// Releases all allocations of @p arena at once.
+///
+/// @details
+/// Grown blocks are returned to allocator, caller-supplied buffer is reused.
+void
+cla_resetArena(
+    cla_arena_t *arena
+);
+
+/// Represents string which is not terminated, e.g. part of argument.
+struct cla_slice_t {
+
+    /// Points to first character.
+    char const *data;
+
+    /// Number of characters.
+    size_t length;
+};
+
+/// Represents value holder of list option, which accumulates repeated arguments.
+///
+/// @details
+/// Items are stored contiguously in cla_result_t::arena,
+/// and stay valid until result is released or reused.
+/// Only lists used with cla_parse() and alike are filled,
+/// as parser without result has no storage for items.
+struct cla_list_t {
+
+    /// Splits every argument on this character, e.g. ','; NUL keeps arguments whole.
+    char separator;
+
+    /// Contiguous items, set by parser; their type depends on handler.
+    void *items;
+
+    /// Number of items, set by parser.
+    size_t numberOfItems;
+
+    /// Number of items which fit into cla_list_t::items, set by parser.
+    size_t capacity;
+
+    /// Next list filled during the same parse, set by parser.
+    cla_list_t *next;
+};
+
+/// Callback handler for lists of strings.
+///
+/// @details
+/// Appends every part of argument to cla_list_t as cla_slice_t,
+/// pointing into argument itself, so no characters are copied.
+///
+/// @warning
+/// Arguments parsed by cla_feed() are transient, so are slices into them.
+///
+/// @returns
+/// Null reference error when option argument or value is not set,
+/// or when parser has no result.
+///
+/// @returns
+/// Out of memory error when result arena is exhausted.
+cla_handler_t
+cla_listHandler;
+
+/// Callback handler for lists of int32_t values.
+///
+/// @details
+/// Decodes every part of argument like cla_int32Handler()
+/// and appends it to cla_list_t of packed int32_t items.
+///
+/// @see cla_listHandler
+cla_handler_t
+cla_int32ListHandler;
+
+/// Callback handler for lists of int64_t values.
+///
+/// @see cla_int32ListHandler
+cla_handler_t
+cla_int64ListHandler;
+
+/// Callback handler for lists of uint32_t values.
+///
+/// @see cla_int32ListHandler
+cla_handler_t
+cla_uint32ListHandler;
+
+/// Callback handler for lists of uint64_t values.
+///
+/// @see cla_int32ListHandler
+cla_handler_t
+cla_uint64ListHandler;
 
 /// Default callback handler for string values.
 ///
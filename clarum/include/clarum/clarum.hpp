@@ -0,0 +1,626 @@
+#pragma once
+
+#include <clarum/clarum.h>
+#include <array>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+/// Header-only C++17 front end over clarum.
+///
+/// @details
+/// Schema is a constexpr list of options bound to members of caller struct:
+///
+///     struct settings_t { std::size_t jobs; bool isVerbose; std::string_view name; };
+///
+///     constexpr auto schema = clarum::makeSchema(
+///         clarum::option<&settings_t::jobs>("jobs", 'j'),
+///         clarum::option<&settings_t::isVerbose>("verbose", 'v'),
+///         clarum::option<&settings_t::name>("name").required());
+///
+///     settings_t settings{};
+///     auto const result = schema.parse(settings, argc, argv);
+///
+/// Names and synonyms are perfect-hashed while schema is compiled, so ill-formed schemas,
+/// e.g. with duplicate keys, do not compile. Arguments are split by cla_tokenize()
+/// and follow the same syntax as cla_parse(); statuses are cla_*Error codes.
+/// Values are decoded straight into typed members, without type erasure or heap.
+namespace clarum {
+
+namespace detail {
+
+/* Is never constant, so schema which reaches it does not compile. */
+inline void
+rejectSchema(
+    char const *reason
+) noexcept {
+    (void) reason;
+    std::abort();
+}
+
+constexpr std::uint32_t
+hashKey(
+    std::string_view key
+) noexcept {
+    std::uint32_t
+        hash = 2166136261u;
+
+    for (char const chr : key) {
+        hash ^= static_cast<unsigned char>(chr);
+        hash *= 16777619u;
+    }
+
+    return hash;
+}
+
+/* Derives independent hash of key from its @hash and @seed. */
+constexpr std::uint32_t
+mixHash(
+    std::uint32_t hash,
+    std::uint32_t seed
+) noexcept {
+    hash ^= seed * 0x9E3779B9u;
+    hash ^= hash >> 16;
+    hash *= 0x85EBCA6Bu;
+    hash ^= hash >> 13;
+    hash *= 0xC2B2AE35u;
+    hash ^= hash >> 16;
+
+    return hash;
+}
+
+constexpr std::size_t
+getPowerOfTwo(
+    std::size_t number
+) noexcept {
+    std::size_t
+        power = 1;
+
+    while (power < number)
+        power *= 2;
+
+    return power;
+}
+
+constexpr bool
+isEscapeCharacter(
+    char chr
+) noexcept {
+    return chr == '-' || chr == '/';
+}
+
+constexpr bool
+isOptionCharacter(
+    char chr
+) noexcept {
+    return chr && !isEscapeCharacter(chr) && chr != '=';
+}
+
+inline int
+decodeValue(
+    bool &value,
+    char *argument,
+    std::size_t length
+) noexcept {
+    cla_option_t
+        option{};
+
+    /* Reuses keywords of C handler, so both front ends accept the same spellings. */
+    option.valuePtr = &value;
+    option.argument = argument;
+    option.argumentLength = length;
+
+    return cla_booleanHandler(nullptr, &option);
+}
+
+inline int
+decodeValue(
+    std::string_view &value,
+    char *argument,
+    std::size_t length
+) noexcept {
+    if (!argument)
+        return cla_nullReferenceError;
+
+    value = std::string_view(argument, length);
+    return cla_noErrors;
+}
+
+inline int
+decodeValue(
+    char const *&value,
+    char *argument,
+    std::size_t length
+) noexcept {
+    (void) length;
+
+    if (!argument)
+        return cla_nullReferenceError;
+
+    value = argument;
+    return cla_noErrors;
+}
+
+template <typename value_t>
+inline std::enable_if_t<std::is_arithmetic_v<value_t>, int>
+decodeValue(
+    value_t &value,
+    char *argument,
+    std::size_t length
+) noexcept {
+    value_t
+        decoded{};
+
+    if (!argument)
+        return cla_nullReferenceError;
+
+    /* Whole argument shall be consumed; value is written only on success. */
+    auto const
+        [end, error] = std::from_chars(argument, argument + length, decoded);
+
+    if (error != std::errc() || end != argument + length)
+        return cla_illegalInputError;
+
+    value = decoded;
+    return cla_noErrors;
+}
+
+} // namespace detail
+
+/// Describes option independently of its value type.
+struct definition_t {
+
+    /// Long option name, empty if there is none.
+    std::string_view name;
+
+    /// Long option synonym, empty if there is none.
+    std::string_view synonym;
+
+    /// Short option tag, '\0' if there is none.
+    char tag;
+
+    /// Specifies whether option shall be referenced.
+    bool isRequired;
+
+    /// Specifies whether parser stops after option.
+    bool isTerminal;
+};
+
+/// Represents option bound to @p member, or flag when @p member is nullptr.
+///
+/// @details
+/// Binding is part of option type only, so schema stores plain definitions
+/// and dispatches decoding statically.
+template <auto member>
+struct option_t : definition_t {
+
+    constexpr option_t
+    withSynonym(
+        std::string_view key
+    ) const noexcept {
+        option_t
+            copy = *this;
+
+        copy.synonym = key;
+        return copy;
+    }
+
+    constexpr option_t
+    required(
+    ) const noexcept {
+        option_t
+            copy = *this;
+
+        copy.isRequired = true;
+        return copy;
+    }
+
+    constexpr option_t
+    terminal(
+    ) const noexcept {
+        option_t
+            copy = *this;
+
+        copy.isTerminal = true;
+        return copy;
+    }
+
+    /// Decodes @p argument into bound member of @p target.
+    template <typename target_t>
+    static int
+    decode(
+        target_t &target,
+        char *argument,
+        std::size_t length
+    ) noexcept {
+        if constexpr (std::is_null_pointer_v<decltype(member)>) {
+            (void) target, (void) argument, (void) length;
+            return cla_noErrors;
+        } else {
+            return detail::decodeValue(target.*member, argument, length);
+        }
+    }
+};
+
+/// Makes option named @p name and tagged @p tag, bound to @p member.
+template <auto member>
+constexpr option_t<member>
+option(
+    std::string_view name,
+    char tag = '\0'
+) noexcept {
+    static_assert(std::is_null_pointer_v<decltype(member)> || std::is_member_object_pointer_v<decltype(member)>,
+        "option shall be bound to data member, or nullptr");
+
+    return option_t<member>{{name, {}, tag, false, false}};
+}
+
+/// Represents outcome of single schema_t::parse() call.
+template <std::size_t numberOfOptions>
+struct result_t {
+
+    /// Status of parse, one of cla_*Error codes.
+    int status;
+
+    /// Is set to first unprocessed argument.
+    char const *next;
+
+    /// Is set iff parser was terminated.
+    bool isTerminated;
+
+    /// Referenced bit per option.
+    std::array<std::uint64_t, numberOfOptions ? (numberOfOptions + 63) / 64 : 1> references;
+
+    /// Checks whether option at @p index was referenced.
+    constexpr bool
+    isReferenced(
+        std::size_t index
+    ) const noexcept {
+        return index < numberOfOptions && references[index / 64] >> (index % 64) & 1;
+    }
+};
+
+/// Represents compiled schema over options of types @p options_t.
+template <typename... options_t>
+class schema_t {
+public:
+    static constexpr std::size_t
+        numberOfOptions = sizeof...(options_t),
+        numberOfKeys = 2 * numberOfOptions,
+        numberOfSlots = detail::getPowerOfTwo(2 * numberOfKeys),
+        numberOfBuckets = numberOfOptions ? numberOfOptions : 1;
+
+    static_assert(numberOfOptions < 0x7FFF, "too many options");
+
+    constexpr explicit
+    schema_t(
+        options_t const &... definitions
+    ) : options{{definitions...}} {
+        for (std::size_t i = 0; i < numberOfOptions; ++i) {
+            keys[2 * i] = options[i].name;
+            keys[2 * i + 1] = options[i].synonym;
+            requiredOptions[i / 64] |= std::uint64_t{options[i].isRequired} << (i % 64);
+            addTag(options[i].tag, i);
+        }
+
+        buildIndex();
+    }
+
+    /// Returns copy of schema which skips unknown options.
+    constexpr schema_t
+    lenient(
+    ) const noexcept {
+        schema_t
+            copy = *this;
+
+        copy.isLenient = true;
+        return copy;
+    }
+
+    /// Resolves long option @p name onto option index, or -1.
+    constexpr int
+    findName(
+        std::string_view name
+    ) const noexcept {
+        std::uint32_t const
+            hash = detail::hashKey(name),
+            displacement = displacements[detail::mixHash(hash, 0) % numberOfBuckets];
+        std::uint16_t const
+            entry = slots[detail::mixHash(hash, displacement + 1) & (numberOfSlots - 1)];
+
+        return entry && keys[entry - 1u] == name
+            ? static_cast<int>((entry - 1u) / 2)
+            : -1;
+    }
+
+    /// Resolves short option @p tag onto option index, or -1.
+    constexpr int
+    findTag(
+        char tag
+    ) const noexcept {
+        return static_cast<int>(tags[static_cast<unsigned char>(tag)]) - 1;
+    }
+
+    /// Returns index of option bound to @p member.
+    template <auto member>
+    static constexpr std::size_t
+    indexOf(
+    ) noexcept {
+        std::size_t
+            index = 0;
+
+        (void) ((std::is_same_v<options_t, option_t<member>> || (++index, false)) || ...);
+        return index;
+    }
+
+    /// Parses @p argc and @p argv into members of @p target, skipping binary name.
+    ///
+    /// @returns
+    /// Result, whose status is the same as cla_parse() would return.
+    template <typename target_t>
+    result_t<numberOfOptions>
+    parse(
+        target_t &target,
+        int argc,
+        char **argv
+    ) const noexcept {
+        result_t<numberOfOptions>
+            result{};
+
+        if (!argv) {
+            result.status = cla_nullReferenceError;
+            return result;
+        }
+
+        for (int i = 1; i < argc && !result.isTerminated && !result.next && !result.status; ++i) {
+            cla_token_t
+                token;
+
+            cla_tokenize(&token, argv[i]);
+            result.status = parseArgument(target, result, token);
+        }
+
+        if (!result.status && isRequiredOptionMissing(result))
+            result.status = cla_missingOptionError;
+
+        return result;
+    }
+
+private:
+    std::array<definition_t, numberOfOptions>
+        options;
+    std::array<std::string_view, numberOfKeys>
+        keys{};
+    std::array<std::uint16_t, numberOfSlots>
+        slots{};
+    std::array<std::uint16_t, numberOfBuckets>
+        displacements{};
+    std::array<std::uint16_t, 256>
+        tags{};
+    std::array<std::uint64_t, numberOfOptions ? (numberOfOptions + 63) / 64 : 1>
+        requiredOptions{};
+    bool
+        isLenient = false;
+
+    constexpr void
+    addTag(
+        char tag,
+        std::size_t index
+    ) {
+        std::uint16_t
+            &entry = tags[static_cast<unsigned char>(tag)];
+
+        if (!tag)
+            return;
+
+        if (entry)
+            detail::rejectSchema("duplicate option tag");
+
+        entry = static_cast<std::uint16_t>(index + 1);
+    }
+
+    static constexpr std::size_t
+    getSlot(
+        std::uint32_t hash,
+        std::uint32_t displacement
+    ) noexcept {
+        return detail::mixHash(hash, displacement + 1) & (numberOfSlots - 1);
+    }
+
+    /* Places largest buckets first, so that small ones fill remaining gaps. */
+    constexpr void
+    buildIndex(
+    ) {
+        std::array<std::uint32_t, numberOfKeys>
+            hashes{};
+        std::array<std::size_t, numberOfKeys>
+            buckets{},
+            members{};
+        std::array<std::size_t, numberOfBuckets>
+            sizes{};
+        std::array<bool, numberOfBuckets>
+            isPlaced{};
+
+        for (std::size_t key = 0; key < numberOfKeys; ++key) {
+            if (keys[key].empty())
+                continue;
+
+            hashes[key] = detail::hashKey(keys[key]);
+            buckets[key] = detail::mixHash(hashes[key], 0) % numberOfBuckets;
+            ++sizes[buckets[key]];
+
+            /* Keys are compared only on equal hashes, which keeps compilation fast. */
+            for (std::size_t other = 0; other < key; ++other) {
+                if (hashes[other] == hashes[key] && !keys[other].empty() && keys[other] == keys[key])
+                    detail::rejectSchema("duplicate option name or synonym");
+            }
+        }
+
+        for (std::size_t n = 0; n < numberOfBuckets; ++n) {
+            std::size_t
+                bucket = 0,
+                numberOfMembers = 0;
+
+            for (std::size_t i = 1; i < numberOfBuckets; ++i) {
+                if (!isPlaced[i] && (isPlaced[bucket] || sizes[i] > sizes[bucket]))
+                    bucket = i;
+            }
+
+            if (!sizes[bucket])
+                /* Remaining buckets are empty. */
+                break;
+
+            isPlaced[bucket] = true;
+
+            for (std::size_t key = 0; key < numberOfKeys; ++key) {
+                if (!keys[key].empty() && buckets[key] == bucket)
+                    members[numberOfMembers++] = key;
+            }
+
+            displacements[bucket] = placeBucket(hashes, members, numberOfMembers);
+        }
+    }
+
+    /* Finds displacement which moves all keys of bucket onto distinct vacant slots. */
+    constexpr std::uint16_t
+    placeBucket(
+        std::array<std::uint32_t, numberOfKeys> const &hashes,
+        std::array<std::size_t, numberOfKeys> const &members,
+        std::size_t numberOfMembers
+    ) {
+        for (std::uint32_t displacement = 0; displacement < 0xFFFF; ++displacement) {
+            bool
+                isVacant = true;
+
+            for (std::size_t i = 0; i < numberOfMembers && isVacant; ++i) {
+                std::size_t const
+                    slot = getSlot(hashes[members[i]], displacement);
+
+                isVacant = !slots[slot];
+                for (std::size_t j = 0; j < i && isVacant; ++j)
+                    isVacant = getSlot(hashes[members[j]], displacement) != slot;
+            }
+
+            if (isVacant) {
+                for (std::size_t i = 0; i < numberOfMembers; ++i)
+                    slots[getSlot(hashes[members[i]], displacement)] = static_cast<std::uint16_t>(members[i] + 1);
+
+                return static_cast<std::uint16_t>(displacement);
+            }
+        }
+
+        detail::rejectSchema("no perfect hash found");
+        return 0;
+    }
+
+    template <typename target_t, std::size_t... indices>
+    int
+    invokeOption(
+        target_t &target,
+        result_t<numberOfOptions> &result,
+        std::size_t index,
+        cla_token_t const &token,
+        std::index_sequence<indices...>
+    ) const noexcept {
+        int
+            status = cla_noErrors;
+
+        result.isTerminated = options[index].isTerminal;
+
+        /* Expands into chain of direct calls, one per option type. */
+        (void) ((index == indices && (
+            status = options_t::decode(target, token.value, token.valueLength),
+            true)) || ...);
+
+        return status;
+    }
+
+    template <typename target_t>
+    int
+    parseOption(
+        target_t &target,
+        result_t<numberOfOptions> &result,
+        int index,
+        cla_token_t const &token
+    ) const noexcept {
+        if (index < 0) {
+            return !isLenient
+                ? result.isTerminated = true, cla_unknowOptionError
+                : cla_noErrors;
+        }
+
+        result.references[static_cast<std::size_t>(index) / 64] |= std::uint64_t{1} << (index % 64);
+
+        return invokeOption(target, result, static_cast<std::size_t>(index), token,
+            std::index_sequence_for<options_t...>());
+    }
+
+    template <typename target_t>
+    int
+    parseArgument(
+        target_t &target,
+        result_t<numberOfOptions> &result,
+        cla_token_t const &token
+    ) const noexcept {
+        char const
+            *argument = token.name;
+        std::size_t const
+            length = token.nameLength;
+
+        if (!length || !detail::isEscapeCharacter(argument[0])) {
+            /* Not a valid option. */
+            result.next = argument;
+            return cla_noErrors;
+        }
+
+        if (length == 1 || !detail::isEscapeCharacter(argument[1])) {
+            int
+                status = cla_noErrors;
+
+            /* Short '-x' or '-abc' form, whole group shares single value. */
+            for (std::size_t i = 1; i < length && detail::isOptionCharacter(argument[i]) && !status; ++i)
+                status = parseOption(target, result, findTag(argument[i]), token);
+
+            return status;
+        }
+
+        if (length == 2)
+            /* '--' is skipped, while '--=value' is malformed. */
+            return token.value
+                ? cla_illegalInputError
+                : cla_noErrors;
+
+        if (!detail::isOptionCharacter(argument[2]))
+            /* Long option has invalid syntax. */
+            return cla_illegalInputError;
+
+        return parseOption(target, result, findName(std::string_view(&argument[2], length - 2)), token);
+    }
+
+    constexpr bool
+    isRequiredOptionMissing(
+        result_t<numberOfOptions> const &result
+    ) const noexcept {
+        for (std::size_t i = 0; i < requiredOptions.size(); ++i) {
+            if ((result.references[i] & requiredOptions[i]) != requiredOptions[i])
+                return true;
+        }
+
+        return false;
+    }
+};
+
+/// Compiles schema over @p options, at compile time when declared constexpr.
+template <typename... options_t>
+constexpr schema_t<options_t...>
+makeSchema(
+    options_t const &... definitions
+) {
+    return schema_t<options_t...>(definitions...);
+}
+
+} // namespace clarum
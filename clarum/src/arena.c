@@ -0,0 +1,169 @@
+#include "arena.h"
+#include <stdlib.h>
+#include <string.h>
+
+/* Alignment of every allocation, sufficient for pointers and 64-bit integers. */
+#define alignment 16
+
+/* Size of first grown block; every next block is at least twice as large. */
+#define minimumBlockSize 4096
+
+/* Precedes every grown block, caller-supplied buffer has no header. */
+typedef struct header_t {
+    struct header_t *next;
+    size_t size;
+} header_t;
+
+/* Header size, rounded up so that data following it stays aligned. */
+#define headerSize \
+    ((sizeof(header_t) + alignment - 1) & ~(size_t) (alignment - 1))
+
+static inline size_t
+alignSize(
+    size_t size
+) {
+    return (size + alignment - 1) & ~(size_t) (alignment - 1);
+}
+
+static inline void *
+allocateFromBlock(
+    cla_arena_t *arena,
+    size_t size
+) {
+    uintptr_t const
+        begin = (uintptr_t) arena->block,
+        address = (begin + arena->used + alignment - 1) & ~(uintptr_t) (alignment - 1);
+
+    if (!arena->block || address - begin > arena->blockSize || arena->blockSize - (address - begin) < size)
+        return NULL;
+
+    arena->used = address - begin + size;
+    return (void *) address;
+}
+
+static inline bool
+growArena(
+    cla_arena_t *arena,
+    size_t size
+) {
+    header_t const
+        *last = arena->blocks;
+    size_t
+        blockSize = last ? 2 * last->size : minimumBlockSize;
+    header_t
+        *header;
+
+    if (!arena->allocator)
+        /* Fixed-size arena. */
+        return false;
+
+    if (blockSize < headerSize + size)
+        blockSize = headerSize + size;
+
+    header = arena->allocator(arena->context, NULL, blockSize);
+    if (!header)
+        return false;
+
+    *header = (header_t) {
+        .next = arena->blocks,
+        .size = blockSize,
+    };
+
+    arena->blocks = header;
+    arena->block = (char *) header + headerSize;
+    arena->blockSize = blockSize - headerSize;
+    arena->used = 0;
+
+    return true;
+}
+
+void *
+cla_allocate(
+    cla_arena_t *arena,
+    size_t size
+) {
+    void
+        *address;
+
+    if (!arena)
+        return NULL;
+
+    if (!arena->block && !arena->blocks) {
+        /* First allocation since reset starts in caller-supplied buffer. */
+        arena->block = arena->buffer;
+        arena->blockSize = arena->bufferSize;
+        arena->used = 0;
+    }
+
+    size = alignSize(size);
+
+    address = allocateFromBlock(arena, size);
+    if (address)
+        return address;
+
+    return growArena(arena, size)
+        ? allocateFromBlock(arena, size)
+        : NULL;
+}
+
+void *
+cla_reallocate(
+    cla_arena_t *arena,
+    void *address,
+    size_t size,
+    size_t newSize
+) {
+    void
+        *newAddress;
+
+    size = alignSize(size);
+    newSize = alignSize(newSize);
+
+    if (address && (char *) address + size == (char *) arena->block + arena->used &&
+        arena->blockSize - arena->used >= newSize - size) {
+        /* Last allocation grows in place. */
+        arena->used += newSize - size;
+        return address;
+    }
+
+    newAddress = cla_allocate(arena, newSize);
+    if (newAddress && address)
+        memcpy(newAddress, address, size);
+
+    return newAddress;
+}
+
+void
+cla_resetArena(
+    cla_arena_t *arena
+) {
+    if (!arena)
+        return;
+
+    for (header_t *header = arena->blocks, *next; header; header = next) {
+        next = header->next;
+        arena->allocator(arena->context, header, header->size);
+    }
+
+    arena->blocks = NULL;
+    arena->block = NULL;
+    arena->blockSize = 0;
+    arena->used = 0;
+}
+
+void *
+cla_heapAllocator(
+    void *context,
+    void *block,
+    size_t size
+) {
+    (void) context;
+    (void) size;
+
+    if (block) {
+        free(block);
+        return NULL;
+    }
+
+    return malloc(size);
+}
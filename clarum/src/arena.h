@@ -0,0 +1,15 @@
+#pragma once
+
+#include <clarum/clarum.h>
+
+/*
+ * Grows allocation at @address from @size to @newSize bytes;
+ * last allocation grows in place while its block has room, others are copied.
+ */
+void *
+cla_reallocate(
+    cla_arena_t *arena,
+    void *address,
+    size_t size,
+    size_t newSize
+);
@@ -0,0 +1,177 @@
+#include <clarum/clarum.h>
+
+enum {
+    /* Number of invocations claimed at once. */
+    grainSize = 16,
+    cacheLineSize = 64,
+    maximumNumberOfThreads = 256,
+};
+
+#if defined(CLARUM_THREADS)
+
+#include <pthread.h>
+#include <stdatomic.h>
+
+/* Represents range of invocations owned by single worker. */
+typedef
+    struct range_t
+    range_t;
+
+struct range_t {
+    _Alignas(cacheLineSize) atomic_size_t begin;
+    size_t end;
+};
+
+typedef
+    struct batch_t
+    batch_t;
+
+struct batch_t {
+    cla_schema_t const *schema;
+    cla_invocation_t const *invocations;
+    cla_result_t *results;
+    range_t *ranges;
+    size_t numberOfWorkers;
+};
+
+typedef
+    struct worker_t
+    worker_t;
+
+struct worker_t {
+    batch_t *batch;
+    size_t index;
+    pthread_t thread;
+};
+
+static inline bool
+drainRange(
+    batch_t *batch,
+    range_t *range
+) {
+    bool
+        hasParsed = false;
+
+    for (;;) {
+        size_t const
+            begin = atomic_fetch_add_explicit(&range->begin, grainSize, memory_order_relaxed);
+
+        if (begin >= range->end)
+            return hasParsed;
+
+        for (size_t i = begin; i < begin + grainSize && i < range->end; ++i) {
+            cla_invocation_t const
+                *invocation = &batch->invocations[i];
+
+            /* Status is recorded into result, batch continues regardless. */
+            cla_parse(batch->schema, &batch->results[i], invocation->argc, invocation->argv);
+        }
+
+        hasParsed = true;
+    }
+}
+
+static void *
+runWorker(
+    void *context
+) {
+    worker_t const
+        *worker = context;
+    batch_t
+        *batch = worker->batch;
+
+    /* Drains own range first, then steals from others until all ranges are empty. */
+    drainRange(batch, &batch->ranges[worker->index]);
+
+    for (bool hasStolen = true; hasStolen; ) {
+        hasStolen = false;
+
+        for (size_t i = 1; i < batch->numberOfWorkers; ++i) {
+            size_t const
+                victim = (worker->index + i) % batch->numberOfWorkers;
+
+            hasStolen |= drainRange(batch, &batch->ranges[victim]);
+        }
+    }
+
+    return NULL;
+}
+
+static void
+parseConcurrently(
+    cla_schema_t const *schema,
+    cla_invocation_t const *invocations,
+    cla_result_t *results,
+    size_t numberOfInvocations,
+    size_t numberOfThreads
+) {
+    range_t
+        ranges[maximumNumberOfThreads];
+    worker_t
+        workers[maximumNumberOfThreads];
+    batch_t
+        batch = {
+            .schema = schema,
+            .invocations = invocations,
+            .results = results,
+            .ranges = ranges,
+            .numberOfWorkers = numberOfThreads,
+        };
+    size_t
+        numberOfStarted = 1;
+
+    for (size_t i = 0; i < numberOfThreads; ++i) {
+        atomic_init(&ranges[i].begin, numberOfInvocations * i / numberOfThreads);
+        ranges[i].end = numberOfInvocations * (i + 1) / numberOfThreads;
+
+        workers[i].batch = &batch;
+        workers[i].index = i;
+    }
+
+    /* Calling thread serves as the first worker; ranges of workers
+     * which could not be started are stolen by the rest. */
+    for (; numberOfStarted < numberOfThreads; ++numberOfStarted) {
+        if (pthread_create(&workers[numberOfStarted].thread, NULL, &runWorker, &workers[numberOfStarted]))
+            break;
+    }
+
+    runWorker(&workers[0]);
+
+    for (size_t i = 1; i < numberOfStarted; ++i)
+        pthread_join(workers[i].thread, NULL);
+}
+
+#endif
+
+int
+cla_parseBatch(
+    cla_schema_t const *schema,
+    cla_invocation_t const *invocations,
+    cla_result_t *results,
+    size_t numberOfInvocations,
+    size_t numberOfThreads
+) {
+    if (!schema || !invocations || !results)
+        /* Null @schema, @invocations, or @results. */
+        return cla_nullReferenceError;
+
+    if (numberOfThreads > numberOfInvocations / grainSize)
+        /* Extra workers would have nothing to do. */
+        numberOfThreads = numberOfInvocations / grainSize;
+
+    if (numberOfThreads > maximumNumberOfThreads)
+        numberOfThreads = maximumNumberOfThreads;
+
+#if defined(CLARUM_THREADS)
+    if (numberOfThreads > 1) {
+        parseConcurrently(schema, invocations, results, numberOfInvocations, numberOfThreads);
+        return cla_noErrors;
+    }
+#endif
+
+    /* Single worker, or library built without threads. */
+    for (size_t i = 0; i < numberOfInvocations; ++i)
+        cla_parse(schema, &results[i], invocations[i].argc, invocations[i].argv);
+
+    return cla_noErrors;
+}
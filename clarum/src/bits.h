@@ -0,0 +1,39 @@
+#pragma once
+
+#include <stdint.h>
+
+/* Counts trailing zero bits of non-zero @value. */
+static inline int
+countTrailingZeros(
+    uint64_t value
+) {
+#if defined(__GNUC__)
+    return __builtin_ctzll(value);
+#else
+    int
+        count = 0;
+
+    for (; !(value & 1); value >>= 1)
+        ++count;
+
+    return count;
+#endif
+}
+
+/* Counts leading zero bits of non-zero @value. */
+static inline int
+countLeadingZeros(
+    uint64_t value
+) {
+#if defined(__GNUC__)
+    return __builtin_clzll(value);
+#else
+    int
+        count = 0;
+
+    for (; !(value & 0x8000000000000000u); value <<= 1)
+        ++count;
+
+    return count;
+#endif
+}
@@ -0,0 +1,451 @@
+#include "bits.h"
+#include "engine.h"
+#include "schema.h"
+#include "statistics.h"
+#include <stdatomic.h>
+
+/* Marks flag arguments, which have no value, and entries which hold no result. */
+static uint64_t const
+    noPosition = UINT64_MAX;
+
+/* Represents fixed head of cache entry, followed by referenced bits, then position and value of each referenced option. */
+typedef
+    struct entry_t
+    entry_t;
+
+/* Entries and counters live in plain caller-provided memory, which atomics access in place. */
+_Static_assert(sizeof(_Atomic uint64_t) == sizeof(uint64_t), "atomic counter differs from plain one");
+
+struct entry_t {
+    /* Odd while entry is written. */
+    _Atomic uint64_t sequence;
+    uint64_t hash;
+    uint64_t numberOfArguments;
+    uint64_t next;
+    uint64_t numberOfRequiredReferences;
+    uint64_t isTerminated;
+};
+
+static inline size_t
+roundSize(
+    size_t size
+) {
+    return (size + sizeof(uint64_t) - 1) & ~(sizeof(uint64_t) - 1);
+}
+
+/* Checks whether value of @option is restored by copy rather than by running its handler. */
+static inline bool
+isCopiedValue(
+    cla_option_t const *option
+) {
+    return option->handler && option->valueSize;
+}
+
+/* Checks whether handler of @option shall run on every occurrence, as built-in list handlers accumulate items. */
+static inline bool
+isAccumulating(
+    cla_option_t const *option
+) {
+    cla_handler_t
+        *handler = option->handler;
+
+    return option->hasSideEffects ||
+        handler == &cla_listHandler ||
+        handler == &cla_int32ListHandler ||
+        handler == &cla_int64ListHandler ||
+        handler == &cla_uint32ListHandler ||
+        handler == &cla_uint64ListHandler;
+}
+
+static inline size_t
+getFixedSize(
+    cla_schema_t const *schema
+) {
+    return sizeof(entry_t) + (cla_numberOfWords(schema->numberOfOptions) + schema->numberOfOptions) * sizeof(uint64_t);
+}
+
+static inline void *
+getHolder(
+    cla_schema_t const *schema,
+    cla_result_t const *result,
+    size_t index
+) {
+    return result->values
+        ? result->values[index]
+        : schema->options[index].valuePtr;
+}
+
+/* Hashes every argument but binary name, which does not affect result. */
+static inline uint64_t
+hashArguments(
+    int argc,
+    char **argv
+) {
+    uint64_t
+        hash = 0x9E3779B97F4A7C15u ^ (uint64_t) argc;
+
+    for (int i = 1; i < argc; ++i) {
+        size_t const
+            length = strlen(argv[i]);
+
+        hash = mixBytes(hash ^ length, argv[i], length);
+    }
+
+    return hash ^ hash >> 29;
+}
+
+static inline entry_t *
+getEntry(
+    cla_cache_t const *cache,
+    uint64_t hash
+) {
+    return (entry_t *) ((unsigned char *) cache->storage +
+        getHomeSlot((uint32_t) (hash >> 32), cache->numberOfEntries) * cache->entrySize);
+}
+
+/* Encodes @argument as index of argument it points into, and offset within it. */
+static inline uint64_t
+findPosition(
+    int argc,
+    char **argv,
+    char const *argument
+) {
+    if (!argument)
+        return noPosition;
+
+    for (int i = 1; i < argc; ++i) {
+        uintptr_t const
+            offset = (uintptr_t) argument - (uintptr_t) argv[i];
+
+        if ((uintptr_t) argument >= (uintptr_t) argv[i] && offset <= strlen(argv[i]) && offset <= UINT32_MAX)
+            return (uint64_t) i << 32 | offset;
+    }
+
+    /* Argument came from elsewhere, e.g. environment. */
+    return 0;
+}
+
+static inline bool
+isAccumulatingResult(
+    cla_schema_t const *schema,
+    cla_result_t const *result
+) {
+    for (size_t word = 0; word < cla_numberOfWords(schema->numberOfOptions); ++word) {
+        for (uint64_t bits = result->references[word]; bits; bits &= bits - 1) {
+            if (isAccumulating(&schema->options[word * 64 + (size_t) countTrailingZeros(bits)]))
+                return true;
+        }
+    }
+
+    return false;
+}
+
+/* Writes @result into entry, which is invalidated when result cannot be encoded. */
+static inline bool
+writeEntry(
+    cla_schema_t const *schema,
+    cla_cache_t const *cache,
+    cla_result_t const *result,
+    entry_t *entry,
+    int argc,
+    char **argv
+) {
+    size_t const
+        numberOfWords = cla_numberOfWords(schema->numberOfOptions);
+    uint64_t
+        *references = (uint64_t *) (entry + 1),
+        *cursor = references + numberOfWords,
+        *end = (uint64_t *) ((unsigned char *) entry + cache->entrySize);
+
+    memcpy(references, result->references, numberOfWords * sizeof *references);
+
+    for (size_t word = 0; word < numberOfWords; ++word) {
+        for (uint64_t bits = result->references[word]; bits; bits &= bits - 1) {
+            size_t const
+                index = word * 64 + (size_t) countTrailingZeros(bits);
+            cla_option_t const
+                *option = &schema->options[index];
+
+            *cursor = findPosition(argc, argv, result->arguments[index]);
+            if (!*cursor++)
+                return false;
+
+            if (isCopiedValue(option)) {
+                void const
+                    *holder = getHolder(schema, result, index);
+
+                if (!holder || (size_t) (end - cursor) * sizeof *cursor < roundSize(option->valueSize))
+                    /* Value cannot be copied, or does not fit. */
+                    return false;
+
+                memcpy(cursor, holder, option->valueSize);
+                cursor += roundSize(option->valueSize) / sizeof *cursor;
+            }
+        }
+    }
+
+    entry->next = findPosition(argc, argv, result->next);
+    if (!entry->next)
+        return false;
+
+    entry->numberOfRequiredReferences = result->numberOfRequiredReferences;
+    entry->isTerminated = result->isTerminated;
+
+    return true;
+}
+
+static inline void
+storeResult(
+    cla_schema_t const *schema,
+    cla_cache_t const *cache,
+    cla_result_t const *result,
+    int argc,
+    char **argv,
+    uint64_t hash
+) {
+    entry_t
+        *entry = getEntry(cache, hash);
+    uint64_t
+        sequence = atomic_load_explicit(&entry->sequence, memory_order_relaxed);
+
+    if (result->numberOfMappings || isAccumulatingResult(schema, result))
+        /* Arguments come from response files, or handlers shall run on every parse. */
+        return;
+
+    if (sequence & 1 || !atomic_compare_exchange_strong_explicit(&entry->sequence, &sequence, sequence + 1,
+            memory_order_acquire, memory_order_relaxed))
+        /* Another writer owns entry. */
+        return;
+
+    if (writeEntry(schema, cache, result, entry, argc, argv)) {
+        entry->hash = hash;
+        entry->numberOfArguments = (uint64_t) argc;
+    } else {
+        entry->numberOfArguments = noPosition;
+    }
+
+    atomic_store_explicit(&entry->sequence, sequence + 2, memory_order_release);
+}
+
+static inline char *
+decodePosition(
+    char **argv,
+    uint64_t position
+) {
+    return position != noPosition
+        ? argv[position >> 32] + (position & UINT32_MAX)
+        : NULL;
+}
+
+/* Checks whether @position lies within current arguments, as colliding command line may be shorter. */
+static inline bool
+isValidPosition(
+    int argc,
+    char **argv,
+    uint64_t position
+) {
+    uint64_t const
+        index = position >> 32;
+
+    if (position == noPosition)
+        return true;
+
+    /* Offset may point at terminator, but not past it. */
+    return index && index < (uint64_t) argc && !memchr(argv[index], '\0', position & UINT32_MAX);
+}
+
+/* Checks whether entry was not written since @sequence was read. */
+static inline bool
+isStableEntry(
+    entry_t const *entry,
+    uint64_t sequence
+) {
+    atomic_thread_fence(memory_order_acquire);
+    return atomic_load_explicit(&entry->sequence, memory_order_relaxed) == sequence;
+}
+
+/* Restores referenced bits and arguments, then copied values; result is left for parser on failure. */
+static inline bool
+restoreResult(
+    cla_schema_t const *schema,
+    cla_cache_t const *cache,
+    cla_result_t *result,
+    int argc,
+    char **argv,
+    uint64_t hash
+) {
+    size_t const
+        numberOfWords = cla_numberOfWords(schema->numberOfOptions);
+    entry_t const
+        *entry = getEntry(cache, hash);
+    uint64_t const
+        sequence = atomic_load_explicit(&entry->sequence, memory_order_acquire),
+        *references = (uint64_t const *) (entry + 1);
+    uint64_t const
+        *cursor = references + numberOfWords;
+
+    if (sequence & 1 || entry->hash != hash || entry->numberOfArguments != (uint64_t) argc ||
+        !isValidPosition(argc, argv, entry->next))
+        /* Entry is being written, or holds another command line. */
+        return false;
+
+    memcpy(result->references, references, numberOfWords * sizeof *references);
+    result->next = decodePosition(argv, entry->next);
+    result->numberOfRequiredReferences = (size_t) entry->numberOfRequiredReferences;
+    result->isTerminated = entry->isTerminated;
+
+    for (size_t word = 0; word < numberOfWords; ++word) {
+        for (uint64_t bits = result->references[word]; bits; bits &= bits - 1) {
+            size_t const
+                index = word * 64 + (size_t) countTrailingZeros(bits);
+
+            if (index >= schema->numberOfOptions || !isValidPosition(argc, argv, *cursor))
+                /* Entry was torn by concurrent writer. */
+                return false;
+
+            result->arguments[index] = decodePosition(argv, *cursor++);
+
+            if (isCopiedValue(&schema->options[index]))
+                cursor += roundSize(schema->options[index].valueSize) / sizeof *cursor;
+        }
+    }
+
+    if (!isStableEntry(entry, sequence))
+        return false;
+
+    /* Referenced options are now known, so parser would overwrite the same holders should copy fail. */
+    cursor = references + numberOfWords;
+
+    for (size_t word = 0; word < numberOfWords; ++word) {
+        for (uint64_t bits = result->references[word]; bits; bits &= bits - 1) {
+            size_t const
+                index = word * 64 + (size_t) countTrailingZeros(bits);
+            cla_option_t const
+                *option = &schema->options[index];
+
+            ++cursor;
+
+            if (isCopiedValue(option)) {
+                memcpy(getHolder(schema, result, index), cursor, option->valueSize);
+                cursor += roundSize(option->valueSize) / sizeof *cursor;
+            }
+        }
+    }
+
+    return isStableEntry(entry, sequence);
+}
+
+/* Counts parse in public counter, which stays plain integer for C++ consumers of header. */
+static inline void
+countParse(
+    uint64_t *counter
+) {
+    atomic_fetch_add_explicit((_Atomic uint64_t *) counter, 1, memory_order_relaxed);
+}
+
+/* Runs handlers of referenced options whose values are not copied. */
+static inline int
+decodeRestoredResult(
+    cla_schema_t const *schema,
+    cla_result_t *result
+) {
+    for (size_t word = 0; word < cla_numberOfWords(schema->numberOfOptions); ++word) {
+        for (uint64_t bits = result->references[word]; bits; bits &= bits - 1) {
+            size_t const
+                index = word * 64 + (size_t) countTrailingZeros(bits);
+            cla_option_t const
+                *option = &schema->options[index];
+            int
+                status;
+
+            if (result->sources)
+                result->sources[index] = cla_argumentSource;
+
+            if (!option->handler || isCopiedValue(option))
+                continue;
+
+            status = cla_decodeArgument(schema, result, index);
+            if (status)
+                return status;
+        }
+    }
+
+    return cla_noErrors;
+}
+
+size_t
+cla_getCacheEntrySize(
+    cla_schema_t const *schema
+) {
+    size_t
+        size;
+
+    if (!schema)
+        return 0;
+
+    size = getFixedSize(schema);
+
+    for (size_t i = 0; i < schema->numberOfOptions; ++i) {
+        cla_option_t const
+            *option = &schema->options[i];
+
+        if (isCopiedValue(option) && !isAccumulating(option))
+            size += roundSize(option->valueSize);
+    }
+
+    return size;
+}
+
+int
+cla_parseCached(
+    cla_schema_t const *schema,
+    cla_cache_t *cache,
+    cla_result_t *result,
+    int argc,
+    char **argv
+) {
+    uint64_t
+        hash;
+    int
+        status;
+
+    if (!schema || !cache || !cache->storage || !result || !argv)
+        /* Null @schema, @cache, its storage, @result, or @argv. */
+        return cla_nullReferenceError;
+
+    if ((uintptr_t) cache->storage % sizeof(uint64_t) || cache->entrySize % sizeof(uint64_t) ||
+        cache->entrySize < getFixedSize(schema) || !cache->numberOfEntries || result->argumentLengths)
+        /* Entries could not be read in place, or do not fit, or result would hold no values. */
+        return cla_illegalInputError;
+
+    if (result->environment || result->configurationPath)
+        /* Result depends on more than command line. */
+        return cla_parse(schema, result, argc, argv);
+
+    if (!result->arguments || !result->references)
+        /* Null @result storage. */
+        return result->status = cla_nullReferenceError;
+
+    hash = hashArguments(argc, argv);
+
+    /* Previous mappings and lists are not referenced by new result. */
+    cla_releaseResult(result);
+    resetStatistics(result);
+    result->schema = schema;
+
+    if (result->diagnostic)
+        memset(result->diagnostic, 0, sizeof *result->diagnostic);
+
+    if (restoreResult(schema, cache, result, argc, argv, hash)) {
+        countParse(&cache->numberOfHits);
+        return result->status = decodeRestoredResult(schema, result);
+    }
+
+    countParse(&cache->numberOfMisses);
+
+    status = cla_parse(schema, result, argc, argv);
+    if (!status)
+        storeResult(schema, cache, result, argc, argv, hash);
+
+    return status;
+}
@@ -0,0 +1,182 @@
+#include "schema.h"
+
+static inline cla_command_t *
+findCommand(
+    cla_dispatcher_t const *dispatcher,
+    char const *name,
+    size_t length
+) {
+    uint32_t const
+        hash = hashKey(name, length);
+
+    for (size_t i = getHomeSlot(hash, dispatcher->numberOfSlots);; ) {
+        cla_slot_t const
+            slot = dispatcher->slots[i];
+
+        if (!slot.entry)
+            /* Reached vacant slot, so @name is not indexed. */
+            return NULL;
+
+        if (slot.hash == hash) {
+            cla_command_t
+                *command = &dispatcher->commands[slot.entry - 1];
+
+            if (keyEquals(command->name, name, length))
+                return command;
+        }
+
+        if (++i == dispatcher->numberOfSlots)
+            i = 0;
+    }
+}
+
+static inline int
+insertCommand(
+    cla_dispatcher_t *dispatcher,
+    size_t index
+) {
+    char const
+        *name = dispatcher->commands[index].name;
+    size_t const
+        length = strlen(name);
+    uint32_t const
+        hash = hashKey(name, length);
+
+    if (findCommand(dispatcher, name, length))
+        /* @name is already taken by another command. */
+        return cla_illegalInputError;
+
+    for (size_t i = getHomeSlot(hash, dispatcher->numberOfSlots);; ) {
+        cla_slot_t
+            *slot = &dispatcher->slots[i];
+
+        if (!slot->entry) {
+            slot->hash = hash;
+            slot->entry = (uint32_t) index + 1;
+            return cla_noErrors;
+        }
+
+        if (++i == dispatcher->numberOfSlots)
+            i = 0;
+    }
+}
+
+int
+cla_compileDispatcher(
+    cla_dispatcher_t *dispatcher
+) {
+    if (!dispatcher || !dispatcher->commands || !dispatcher->slots)
+        /* Null @dispatcher, or its storage. */
+        return cla_nullReferenceError;
+
+    if (dispatcher->numberOfSlots < cla_numberOfSlots(dispatcher->numberOfCommands) ||
+        dispatcher->numberOfCommands >= UINT32_MAX)
+        /* Index would be overloaded, or entries would not fit. */
+        return cla_illegalInputError;
+
+    memset(dispatcher->slots, 0, dispatcher->numberOfSlots * sizeof *dispatcher->slots);
+
+    for (size_t i = 0; i < dispatcher->numberOfCommands; ++i) {
+        cla_command_t const
+            *command = &dispatcher->commands[i];
+        int
+            status;
+
+        if (!command->schema)
+            /* Command schema is compiled on demand, so it shall be set. */
+            return cla_nullReferenceError;
+
+        if (!command->name || !command->name[0])
+            /* Command cannot be named on command line. */
+            return cla_illegalInputError;
+
+        status = insertCommand(dispatcher, i);
+        if (status)
+            return status;
+    }
+
+    return cla_noErrors;
+}
+
+/* Returns position of @name within @argv, or zero when @name does not come from @argv. */
+static inline int
+findArgument(
+    int argc,
+    char **argv,
+    char const *name
+) {
+    for (int i = 1; i < argc; ++i) {
+        if (argv[i] == name)
+            return i;
+    }
+
+    return 0;
+}
+
+int
+cla_dispatch(
+    cla_dispatcher_t const *dispatcher,
+    cla_result_t *globalResult,
+    cla_result_t *commandResult,
+    int argc,
+    char **argv,
+    cla_command_t **command
+) {
+    char const
+        *name;
+    cla_command_t
+        *selected;
+    int
+        position;
+
+    if (!dispatcher || !dispatcher->commands || !dispatcher->slots || !commandResult || !argv || !command ||
+        (dispatcher->globals && !globalResult))
+        /* Null @dispatcher, its storage, @commandResult, @argv, @command, or @globalResult. */
+        return cla_nullReferenceError;
+
+    *command = NULL;
+
+    if (dispatcher->globals) {
+        int const
+            status = cla_parse(dispatcher->globals, globalResult, argc, argv);
+
+        if (status || globalResult->isTerminated)
+            /* Global options failed, or completed invocation, e.g. '--help'. */
+            return status;
+
+        name = globalResult->next;
+    } else {
+        name = argc > 1
+            ? argv[1]
+            : NULL;
+    }
+
+    if (!name)
+        /* No command is given. */
+        return cla_missingOptionError;
+
+    position = findArgument(argc, argv, name);
+    if (!position)
+        /* Command name came from response file. */
+        return cla_illegalInputError;
+
+    selected = findCommand(dispatcher, name, strlen(name));
+    if (!selected)
+        /* No command has such name. */
+        return cla_unknowOptionError;
+
+    *command = selected;
+
+    if (!selected->isCompiled) {
+        int const
+            status = cla_compileSchema(selected->schema);
+
+        if (status)
+            return status;
+
+        selected->isCompiled = true;
+    }
+
+    /* Command name takes place of binary name. */
+    return cla_parse(selected->schema, commandResult, argc - position, &argv[position]);
+}
@@ -0,0 +1,473 @@
+#include "bits.h"
+#include "decimal.h"
+#include "powers.h"
+#include <float.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Number of decimal digits which always fit uint64_t. */
+#define maximumNumberOfFastDigits 19
+
+/* Digits kept by slow path; enough to tell any halfway point of double apart. */
+#define maximumNumberOfSlowDigits 800
+
+typedef struct {
+    int mantissaBits;
+    int exponentBits;
+    int minimumExponent;
+    int infinitePower;
+    int minimumRoundToEvenPower;
+    int maximumRoundToEvenPower;
+    int smallestPowerOfTen;
+    int largestPowerOfTen;
+} format_t;
+
+typedef struct {
+    char const *integer;
+    size_t integerLength;
+    char const *fraction;
+    size_t fractionLength;
+    /* Leading significant digits and their decimal exponent. */
+    uint64_t mantissa;
+    int64_t exponent;
+    /* Exponent following 'e', clamped. */
+    int64_t explicitExponent;
+    bool isNegative;
+    /* Whether non-zero digits were dropped from mantissa. */
+    bool isTruncated;
+} number_t;
+
+static format_t const
+    doubleFormat = {
+        .mantissaBits = 52,
+        .exponentBits = 11,
+        .minimumExponent = -1023,
+        .infinitePower = 0x7FF,
+        .minimumRoundToEvenPower = -4,
+        .maximumRoundToEvenPower = 23,
+        .smallestPowerOfTen = -342,
+        .largestPowerOfTen = 308,
+    },
+    floatFormat = {
+        .mantissaBits = 23,
+        .exponentBits = 8,
+        .minimumExponent = -127,
+        .infinitePower = 0xFF,
+        .minimumRoundToEvenPower = -17,
+        .maximumRoundToEvenPower = 10,
+        .smallestPowerOfTen = -65,
+        .largestPowerOfTen = 38,
+    };
+
+static inline bool
+isDigit(
+    char chr
+) {
+    return chr >= '0' && chr <= '9';
+}
+
+static inline bool
+isLiteral(
+    char const *str,
+    size_t length,
+    char const *literal
+) {
+    size_t
+        i = 0;
+
+    /* Compares case-insensitively; @literal is lowercase. */
+    for (; i < length && literal[i]; ++i)
+        if ((str[i] | 0x20) != literal[i])
+            return false;
+
+    return i == length && !literal[i];
+}
+
+static inline uint64_t
+getInfinity(
+    format_t const *format
+) {
+    return (uint64_t) format->infinitePower << format->mantissaBits;
+}
+
+static inline uint64_t
+getSignBit(
+    format_t const *format,
+    bool isNegative
+) {
+    return (uint64_t) isNegative << (format->mantissaBits + format->exponentBits);
+}
+
+static inline void
+multiply(
+    uint64_t left,
+    uint64_t right,
+    uint64_t *high,
+    uint64_t *low
+) {
+#if defined(__SIZEOF_INT128__)
+    unsigned __int128 const
+        product = (unsigned __int128) left * right;
+
+    *high = (uint64_t) (product >> 64);
+    *low = (uint64_t) product;
+#else
+    uint64_t const
+        leftLow = (uint32_t) left,
+        leftHigh = left >> 32,
+        rightLow = (uint32_t) right,
+        rightHigh = right >> 32,
+        lowLow = leftLow * rightLow,
+        highLow = leftHigh * rightLow,
+        lowHigh = leftLow * rightHigh,
+        middle = (lowLow >> 32) + (uint32_t) highLow + lowHigh;
+
+    *high = leftHigh * rightHigh + (highLow >> 32) + (middle >> 32);
+    *low = (middle << 32) | (uint32_t) lowLow;
+#endif
+}
+
+/*
+ * Eisel-Lemire: rounds @mantissa * 10^@exponent to @format, returning its bits without sign.
+ * Truncated 128-bit product of normalized mantissa and 5^exponent is always sufficient
+ * to round correctly when mantissa has at most 19 digits.
+ */
+static uint64_t
+computeFloat(
+    format_t const *format,
+    uint64_t mantissa,
+    int64_t exponent
+) {
+    uint64_t const
+        precisionMask = UINT64_MAX >> (format->mantissaBits + 3);
+    uint64_t const
+        *power;
+    uint64_t
+        high,
+        low,
+        result;
+    int
+        numberOfLeadingZeros,
+        upperBit,
+        shift;
+    int32_t
+        binaryExponent;
+
+    if (!mantissa || exponent < format->smallestPowerOfTen)
+        return 0;
+
+    if (exponent > format->largestPowerOfTen)
+        return getInfinity(format);
+
+    numberOfLeadingZeros = countLeadingZeros(mantissa);
+    mantissa <<= numberOfLeadingZeros;
+    power = powersOfFive[exponent - smallestPowerOfFive];
+
+    multiply(mantissa, power[0], &high, &low);
+
+    if ((high & precisionMask) == precisionMask) {
+        /* Bits below rounding position are all set; refines product with lower half of power. */
+        uint64_t
+            secondHigh,
+            secondLow;
+
+        multiply(mantissa, power[1], &secondHigh, &secondLow);
+        low += secondHigh;
+        high += secondHigh > low;
+    }
+
+    upperBit = (int) (high >> 63);
+    shift = upperBit + 64 - format->mantissaBits - 3;
+    result = high >> shift;
+    /* Approximates floor(log2(10^exponent)) + 63. */
+    binaryExponent = (int32_t) (((217706 * (int32_t) exponent) >> 16) + 63 + upperBit - numberOfLeadingZeros - format->minimumExponent);
+
+    if (binaryExponent <= 0) {
+        /* Subnormal value. */
+        if (-binaryExponent + 1 >= 64)
+            return 0;
+
+        result >>= -binaryExponent + 1;
+        result += result & 1;
+        result >>= 1;
+
+        /* Rounding up into implicit bit yields smallest normal value, whose exponent field is 1. */
+        return result;
+    }
+
+    if (low <= 1 && exponent >= format->minimumRoundToEvenPower && exponent <= format->maximumRoundToEvenPower &&
+        (result & 3) == 1 && (result << shift) == high)
+        /* Exactly halfway between two values; rounds to even instead of up. */
+        result &= ~UINT64_C(1);
+
+    result += result & 1;
+    result >>= 1;
+
+    if (result >= (UINT64_C(2) << format->mantissaBits)) {
+        /* Rounding carried into next binary exponent. */
+        result = UINT64_C(1) << format->mantissaBits;
+        ++binaryExponent;
+    }
+
+    if (binaryExponent >= format->infinitePower)
+        return getInfinity(format);
+
+    return (result & ~(UINT64_C(1) << format->mantissaBits)) | (uint64_t) binaryExponent << format->mantissaBits;
+}
+
+static inline void
+appendDigit(
+    number_t *number,
+    char digit,
+    bool isFraction,
+    size_t *numberOfDigits
+) {
+    unsigned const
+        value = (unsigned) (digit - '0');
+
+    if (!*numberOfDigits && !value) {
+        /* Leading zeros only shift fraction. */
+        number->exponent -= isFraction;
+        return;
+    }
+
+    if (*numberOfDigits < maximumNumberOfFastDigits) {
+        number->mantissa = number->mantissa * 10 + value;
+        number->exponent -= isFraction;
+        ++*numberOfDigits;
+        return;
+    }
+
+    /* Dropped digits of integer part still scale mantissa. */
+    number->exponent += !isFraction;
+    number->isTruncated |= value != 0;
+}
+
+static int
+parseNumber(
+    number_t *number,
+    char const *str,
+    size_t length
+) {
+    /* Exponents past this bound saturate, which is way past any representable value. */
+    int64_t const
+        maximumExplicitExponent = 0x10000;
+    size_t
+        i = 0,
+        numberOfDigits = 0;
+
+    *number = (number_t) {
+        .isNegative = length && str[0] == '-',
+    };
+
+    if (length && (str[0] == '-' || str[0] == '+'))
+        ++i;
+
+    number->integer = &str[i];
+    for (; i < length && isDigit(str[i]); ++i)
+        appendDigit(number, str[i], false, &numberOfDigits);
+    number->integerLength = (size_t) (&str[i] - number->integer);
+
+    if (i < length && str[i] == '.') {
+        number->fraction = &str[++i];
+        for (; i < length && isDigit(str[i]); ++i)
+            appendDigit(number, str[i], true, &numberOfDigits);
+        number->fractionLength = (size_t) (&str[i] - number->fraction);
+    }
+
+    if (!number->integerLength && !number->fractionLength)
+        /* @str has no digits. */
+        return cla_illegalInputError;
+
+    if (i < length && (str[i] == 'e' || str[i] == 'E')) {
+        bool const
+            isNegative = i + 1 < length && str[i + 1] == '-';
+        size_t const
+            start = i + 1 + (i + 1 < length && (str[i + 1] == '-' || str[i + 1] == '+'));
+
+        for (i = start; i < length && isDigit(str[i]); ++i)
+            if (number->explicitExponent < maximumExplicitExponent)
+                number->explicitExponent = number->explicitExponent * 10 + (str[i] - '0');
+
+        if (i == start)
+            /* Exponent has no digits. */
+            return cla_illegalInputError;
+
+        if (isNegative)
+            number->explicitExponent = -number->explicitExponent;
+    }
+
+    number->exponent += number->explicitExponent;
+
+    return i == length
+        ? cla_noErrors
+        /* @str has trailing characters. */
+        : cla_illegalInputError;
+}
+
+/*
+ * Fallback for long mantissas that land close to halfway point.
+ * Rewrites number as integral digits and exponent, which no locale interprets differently,
+ * and hands it to the C library; digits past the kept ones only matter as being non-zero.
+ */
+static uint64_t
+computeFloatSlowly(
+    format_t const *format,
+    number_t const *number
+) {
+    char
+        buffer[maximumNumberOfSlowDigits + 32];
+    size_t
+        numberOfDigits = 0;
+    int64_t
+        exponent = number->explicitExponent;
+    bool
+        isTruncated = false;
+    uint64_t
+        bits;
+
+    for (size_t i = 0; i < number->integerLength + number->fractionLength; ++i) {
+        bool const
+            isFraction = i >= number->integerLength;
+        char const
+            digit = isFraction ? number->fraction[i - number->integerLength] : number->integer[i];
+
+        if (!numberOfDigits && digit == '0') {
+            exponent -= isFraction;
+        } else if (numberOfDigits < maximumNumberOfSlowDigits) {
+            buffer[numberOfDigits++] = digit;
+            exponent -= isFraction;
+        } else {
+            exponent += !isFraction;
+            isTruncated |= digit != '0';
+        }
+    }
+
+    if (isTruncated) {
+        buffer[numberOfDigits++] = '1';
+        --exponent;
+    }
+
+    snprintf(&buffer[numberOfDigits], sizeof buffer - numberOfDigits, "e%lld", (long long) exponent);
+
+    if (format == &floatFormat) {
+        float const
+            value = strtof(buffer, NULL);
+        uint32_t
+            floatBits;
+
+        memcpy(&floatBits, &value, sizeof floatBits);
+        bits = floatBits;
+    } else {
+        double const
+            value = strtod(buffer, NULL);
+
+        memcpy(&bits, &value, sizeof bits);
+    }
+
+    return bits;
+}
+
+static int
+decodeBits(
+    format_t const *format,
+    uint64_t *bits,
+    char const *str,
+    size_t length
+) {
+    number_t
+        number;
+    size_t
+        start = length && (str[0] == '-' || str[0] == '+');
+    int
+        status;
+
+    if (isLiteral(&str[start], length - start, "inf") || isLiteral(&str[start], length - start, "infinity")) {
+        *bits = getInfinity(format) | getSignBit(format, str[0] == '-');
+        return cla_noErrors;
+    }
+
+    if (isLiteral(&str[start], length - start, "nan")) {
+        /* Quiet NaN. */
+        *bits = getInfinity(format) | UINT64_C(1) << (format->mantissaBits - 1) | getSignBit(format, str[0] == '-');
+        return cla_noErrors;
+    }
+
+    status = parseNumber(&number, str, length);
+    if (status)
+        return status;
+
+#if FLT_EVAL_METHOD == 0
+    if (format == &doubleFormat && !number.isTruncated && number.mantissa <= UINT64_C(1) << 53 &&
+        number.exponent >= -22 && number.exponent <= 22) {
+        /* Both operands are exact, so single rounding by division or multiplication is correct. */
+        static double const
+            powersOfTen[] = {
+                1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+                1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22,
+            };
+        double
+            value = (double) number.mantissa;
+
+        value = number.exponent < 0
+            ? value / powersOfTen[-number.exponent]
+            : value * powersOfTen[number.exponent];
+
+        memcpy(bits, &value, sizeof *bits);
+        *bits |= getSignBit(format, number.isNegative);
+        return cla_noErrors;
+    }
+#endif
+
+    *bits = computeFloat(format, number.mantissa, number.exponent);
+
+    if (number.isTruncated && *bits != computeFloat(format, number.mantissa + 1, number.exponent))
+        /* Dropped digits decide rounding. */
+        *bits = computeFloatSlowly(format, &number);
+
+    if ((*bits & getInfinity(format)) == getInfinity(format))
+        /* Value overflows. */
+        return cla_illegalInputError;
+
+    *bits |= getSignBit(format, number.isNegative);
+    return cla_noErrors;
+}
+
+int
+cla_decodeDouble(
+    double *value,
+    char const *str,
+    size_t length
+) {
+    uint64_t
+        bits;
+    int const
+        status = decodeBits(&doubleFormat, &bits, str, length);
+
+    if (!status)
+        memcpy(value, &bits, sizeof *value);
+
+    return status;
+}
+
+int
+cla_decodeFloat(
+    float *value,
+    char const *str,
+    size_t length
+) {
+    uint64_t
+        bits;
+    uint32_t
+        floatBits;
+    int const
+        status = decodeBits(&floatFormat, &bits, str, length);
+
+    if (!status) {
+        floatBits = (uint32_t) bits;
+        memcpy(value, &floatBits, sizeof *value);
+    }
+
+    return status;
+}
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <clarum/clarum.h>
+
+/*
+ * Decodes decimal floating-point number spanning exactly @length bytes of @str,
+ * rounding to nearest, ties to even, independent of locale.
+ * Accepts optional sign, 'inf', 'infinity' and 'nan' in any case;
+ * values overflowing to infinity are rejected.
+ */
+int
+cla_decodeDouble(
+    double *value,
+    char const *str,
+    size_t length
+);
+
+int
+cla_decodeFloat(
+    float *value,
+    char const *str,
+    size_t length
+);
@@ -1,5 +1,17 @@
-#include <clarum/clarum.h>
-#include <string.h>
+#include "arena.h"
+#include "bits.h"
+#include "engine.h"
+#include "mapping.h"
+#include "schema.h"
+#include "statistics.h"
+#include "suggestion.h"
+#include "tokenizer.h"
+#include <limits.h>
+
+#if !defined(PATH_MAX)
+/* E.g. GNU Hurd, or Windows, which define no path limit. */
+#define PATH_MAX 4096
+#endif
 
 static inline bool
 isEscapeCharacter(
@@ -24,91 +36,315 @@ isOptionCharacter(
         : false;
 }
 
-static inline bool
-optionNameEquals(
-    cla_option_t const *option,
-    char const *str
-) {
-    return option->name
-        ? !memcmp(str, option->name, strlen(option->name))
-        : false;
-}
-
-static inline bool
-optionSynonymEquals(
-    cla_option_t const *option,
-    char const *str
-) {
-    return option->synonym
-        ? !memcmp(str, option->synonym, strlen(option->synonym))
-        : false;
-}
-
 static inline bool
 isReferencedOption(
     cla_option_t const *option,
     char const *str,
-    bool byTag
+    size_t length
 ) {
-    return byTag
-        ? *str == option->tag
-        : optionNameEquals(option, str) || optionSynonymEquals(option, str);
+    return keyEquals(option->name, str, length) || keyEquals(option->synonym, str, length);
 }
 
 static inline cla_option_t *
 getOption(
     cla_parser_t *parser,
     char const *str,
+    size_t length,
     bool byTag
 ) {
+    addStatistic(parser->result, numberOfLookups, 1);
+
+    if (byTag) {
+        if (parser->schema)
+            /* Resolves via compiled tag table. */
+            return findTaggedOption(parser->schema, *str);
+
+        for (size_t i = 0; i < parser->numberOfOptions; ++i) {
+            if (*str == parser->options[i].tag)
+                return &parser->options[i];
+        }
+
+        return NULL;
+    }
+
+    if (parser->schema)
+        /* Resolves via compiled index. */
+        return findOption(parser->schema, parser->result, str, length);
+
     for (size_t i = 0; i < parser->numberOfOptions; ++i) {
         cla_option_t
             *current = &parser->options[i];
 
-        if (isReferencedOption(current, str, byTag))
+        if (isReferencedOption(current, str, length))
             return current;
     }
 
     return NULL;
 }
 
-static inline char *
-getArgument(
-    char *str
+static inline bool
+isReferencedIndex(
+    cla_result_t const *result,
+    size_t index
+) {
+    return result->references[index / 64] >> (index % 64) & 1;
+}
+
+/* Reports resolved, or unknown option token to tracer, if any. */
+static inline void
+traceToken(
+    cla_parser_t const *parser,
+    cla_option_t const *option,
+    char const *str,
+    size_t length,
+    token_t const *token
 ) {
-    for (size_t i = 0; i < strlen(str); ++i) {
-        if (isDelimiterCharacter(str[i]))
-            /* Increments to skip the delimiter. */
-            return &str[i + 1];
+#if defined(CLARUM_STATISTICS)
+    cla_result_t const
+        *result = parser->result;
+
+    if (result && result->tracer) {
+        cla_event_t const
+            event = {
+                .kind = cla_tokenEvent,
+                .option = option,
+                .name = str,
+                .nameLength = length,
+                .argument = token->value,
+                .argumentLength = token->valueLength,
+            };
+
+        result->tracer(result->tracerContext, &event);
     }
+#else
+    (void) parser, (void) option, (void) str, (void) length, (void) token;
+#endif
+}
 
-    return NULL;
+/* Invokes handler of @option on @copy, timing and tracing the call when statistics are collected. */
+static inline int
+invokeHandler(
+    cla_parser_t *parser,
+    cla_option_t const *option,
+    cla_option_t *copy
+) {
+#if defined(CLARUM_STATISTICS)
+    cla_result_t
+        *result = parser->result;
+    uint64_t const
+        start = getTimestamp();
+    int const
+        status = option->handler(parser, copy);
+    uint64_t const
+        duration = getTimestamp() - start;
+
+    ++result->statistics.numberOfHandlerCalls;
+    result->statistics.handlerTime += duration;
+
+    if (result->tracer) {
+        cla_event_t const
+            event = {
+                .kind = cla_handlerEvent,
+                .option = option,
+                .name = option->name,
+                .nameLength = option->name ? strlen(option->name) : 0,
+                .argument = copy->argument,
+                .argumentLength = copy->argumentLength,
+                .status = status,
+                .duration = duration,
+            };
+
+        result->tracer(result->tracerContext, &event);
+    }
+
+    return status;
+#else
+    return option->handler(parser, copy);
+#endif
+}
+
+static inline cla_diagnostic_t *
+getDiagnostic(
+    cla_parser_t const *parser
+) {
+    return parser->result
+        ? parser->result->diagnostic
+        : NULL;
+}
+
+/* Records offending token of failed parse, keeping the first one reported. */
+static inline void
+reportToken(
+    cla_diagnostic_t *diagnostic,
+    cla_option_t const *option,
+    char const *str,
+    size_t length
+) {
+    if (diagnostic && !diagnostic->token) {
+        diagnostic->token = str;
+        diagnostic->tokenLength = length;
+        diagnostic->option = option;
+    }
+}
+
+/* Records unknown option together with options named closest to it. */
+static inline void
+reportUnknownOption(
+    cla_parser_t const *parser,
+    char const *str,
+    size_t length,
+    bool byTag
+) {
+    cla_diagnostic_t
+        *diagnostic = getDiagnostic(parser);
+
+    if (!diagnostic || diagnostic->token)
+        return;
+
+    reportToken(diagnostic, NULL, str, length);
+
+    if (!byTag && parser->schema)
+        /* Tags are single characters, too short to resemble anything. */
+        cla_suggestOptions(parser->schema, diagnostic, str, length);
+}
+
+/* Records where offending token lies, unless it was recorded for word of nested response file. */
+static inline void
+reportOrigin(
+    cla_diagnostic_t *diagnostic,
+    int source,
+    char const *origin
+) {
+    if (diagnostic && diagnostic->token && !diagnostic->source) {
+        diagnostic->source = source;
+        diagnostic->offset = (size_t) (diagnostic->token - origin);
+    }
+}
+
+static inline void
+reportIndex(
+    cla_diagnostic_t *diagnostic,
+    size_t index
+) {
+    if (diagnostic && !diagnostic->index)
+        diagnostic->index = index;
+}
+
+static inline bool
+isDecodedIndex(
+    cla_result_t const *result,
+    size_t index
+) {
+    return result->decodedOptions[index / 64] >> (index % 64) & 1;
+}
+
+/* Runs handler of @option on @argument, storing value into result value holder, if any. */
+static inline int
+decodeOption(
+    cla_parser_t *parser,
+    cla_option_t const *option,
+    size_t index,
+    char *argument,
+    size_t argumentLength
+) {
+    cla_result_t
+        *result = parser->result;
+    /* Handler receives private copy, shared option stays intact. */
+    cla_option_t
+        copy = *option;
+
+    copy.argument = argument;
+    copy.argumentLength = argumentLength;
+    copy.isReferenced = true;
+
+    if (result->values)
+        copy.valuePtr = result->values[index];
+
+    return invokeHandler(parser, option, &copy);
+}
+
+static inline int
+recordOption(
+    cla_parser_t *parser,
+    cla_option_t const *option,
+    token_t const *token,
+    unsigned char source
+) {
+    cla_result_t
+        *result = parser->result;
+    size_t const
+        index = (size_t) (option - parser->options);
+
+    if (!isReferencedIndex(result, index)) {
+        result->references[index / 64] |= (uint64_t) 1 << (index % 64);
+        result->numberOfRequiredReferences += option->isRequired;
+    }
+
+    result->arguments[index] = token->value;
+
+    if (result->sources)
+        result->sources[index] = source;
+
+    if (result->argumentLengths) {
+        /* Lazy result, value is decoded by cla_get(). */
+        result->argumentLengths[index] = token->valueLength;
+        return cla_noErrors;
+    }
+
+    return option->handler
+        ? decodeOption(parser, option, index, token->value, token->valueLength)
+        : cla_noErrors;
 }
 
 static inline int
 parseOption(
     cla_parser_t *parser,
     char *str,
+    size_t length,
+    token_t const *token,
     bool byTag
 ) {
-    if (!str[0])
-        /* @str = '--\0', this stops parsing by convention. */
-        return cla_noErrors; 
-    
+    if (!length)
+        /* @str = '--\0' is skipped, while '--=value' is malformed. */
+        return token->value
+            ? cla_illegalInputError
+            : cla_noErrors;
+
     if (isOptionCharacter(str[0])) {
         cla_option_t
-            *option = getOption(parser, str, byTag);
+            *option = getOption(parser, str, length, byTag);
+
+        traceToken(parser, option, str, length, token);
 
         if (!option) {
-            return !parser->isLenient
-                ? parser->isTerminated = true, cla_unknowOptionError
-                : cla_noErrors;
+            if (parser->isLenient)
+                return cla_noErrors;
+
+            parser->isTerminated = true;
+            reportUnknownOption(parser, str, length, byTag);
+
+            return cla_unknowOptionError;
         }
 
-        option->isReferenced = true;
-        option->argument = getArgument(str);
         parser->isTerminated = option->isTerminal;
 
+        if (parser->result) {
+            int const
+                status = recordOption(parser, option, token, cla_argumentSource);
+
+            if (status) {
+                /* Flags have no value, so their name is reported instead. */
+                reportToken(getDiagnostic(parser), option,
+                    token->value ? token->value : str, token->value ? token->valueLength : length);
+            }
+
+            return status;
+        }
+
+        option->isReferenced = true;
+        option->argument = token->value;
+        option->argumentLength = token->valueLength;
+
         return option->handler
             ? option->handler(parser, option)
             : cla_noErrors;
@@ -118,6 +354,152 @@ parseOption(
     return cla_illegalInputError;
 }
 
+static int
+expandResponseFile(
+    cla_parser_t *parser,
+    char const *path,
+    size_t length,
+    unsigned depth
+);
+
+static inline bool
+canExpandResponseFile(
+    cla_parser_t const *parser,
+    token_t const *token
+) {
+    return token->nameLength && token->name[0] == '@' && parser->result && parser->result->mappings;
+}
+
+/* Resolves argument as response file, short option group, or long option. */
+static inline int
+dispatchArgument(
+    cla_parser_t *parser,
+    token_t const *token,
+    unsigned depth
+) {
+    char
+        *argument = token->name;
+    size_t const
+        length = token->nameLength;
+
+    if (canExpandResponseFile(parser, token)) {
+        /* Path spans whole argument, including delimiters. */
+        return expandResponseFile(parser, &argument[1],
+            length + (token->value ? token->valueLength + 1 : 0) - 1, depth);
+    }
+
+    if (!length || !isEscapeCharacter(argument[0])) {
+        /* Not a valid option. */
+        parser->next = argument;
+        return cla_noErrors;
+    }
+
+    if (length == 1 || !isEscapeCharacter(argument[1])) {
+        int
+            status = cla_noErrors;
+
+        /* Short '-x' or '-abc' form, whole group shares single value. */
+        for (size_t i = 1; i < length && isOptionCharacter(argument[i]) && !status; ++i)
+            status = parseOption(parser, &argument[i], 1, token, true);
+
+        return status;
+    }
+
+    /* Long '--name' form. */
+    return parseOption(parser, &argument[2], length - 2, token, false);
+}
+
+/* Parses single argument split by tokenizer, which need not be terminated. */
+static inline int
+parseArgument(
+    cla_parser_t *parser,
+    token_t const *token,
+    unsigned depth
+) {
+    char
+        *argument = token->name;
+    size_t const
+        length = token->nameLength;
+    int
+        status;
+
+    addStatistic(parser->result, numberOfArguments, 1);
+
+    status = dispatchArgument(parser, token, depth);
+
+    if (status) {
+        cla_diagnostic_t
+            *diagnostic = getDiagnostic(parser);
+
+        /* Malformed arguments, and failed response files are reported whole. */
+        reportToken(diagnostic, NULL, argument, length + (token->value ? token->valueLength + 1 : 0));
+        reportOrigin(diagnostic, cla_argumentSource, argument);
+    }
+
+    return status;
+}
+
+static int
+expandResponseFile(
+    cla_parser_t *parser,
+    char const *path,
+    size_t length,
+    unsigned depth
+) {
+    cla_result_t
+        *result = parser->result;
+    cla_mapping_t
+        *mapping;
+    char
+        terminatedPath[PATH_MAX],
+        *cursor,
+        *end,
+        *word;
+    int
+        status;
+
+    if (depth >= cla_maximumResponseFileDepth)
+        /* Response files are nested too deeply, or reference each other. */
+        return cla_illegalInputError;
+
+    if (length >= sizeof terminatedPath)
+        /* @path cannot name a file. */
+        return cla_fileError;
+
+    if (result->numberOfMappings == result->maximumNumberOfMappings)
+        /* No storage left for another mapping. */
+        return cla_outOfMemoryError;
+
+    /* Argument may come from unterminated buffer. */
+    memcpy(terminatedPath, path, length);
+    terminatedPath[length] = '\0';
+
+    mapping = &result->mappings[result->numberOfMappings];
+
+    status = cla_mapFile(mapping, terminatedPath);
+    if (status)
+        return status;
+
+    ++result->numberOfMappings;
+
+    cursor = mapping->address;
+    end = cursor + mapping->size;
+
+    /* Words point into mapping, so no copies are made. */
+    while (!parser->isTerminated && !parser->next && (word = splitWord(&cursor, end))) {
+        token_t
+            token;
+
+        tokenize(&token, word);
+
+        status = parseArgument(parser, &token, depth + 1);
+        if (status)
+            return status;
+    }
+
+    return cla_noErrors;
+}
+
 static inline int
 parseOptions(
     cla_parser_t *parser,
@@ -127,29 +509,81 @@ parseOptions(
     int
         status = cla_noErrors;
 
-    for (; numberOfArguments-- && !parser->isTerminated; ++arguments) {
-        char
-            *argument = *arguments;
+    parser->next = NULL;
 
-        if (!isEscapeCharacter(argument[0])) {
-            /* Not a valid option. */
-            parser->next = argument;
-            break;
+    /* First argument (binary name) is already skipped. */
+    for (size_t index = 1; numberOfArguments-- && !parser->isTerminated && !parser->next; ++arguments, ++index) {
+        token_t
+            token;
+
+        tokenize(&token, *arguments);
+
+        status = parseArgument(parser, &token, 0);
+        if (status) {
+            reportIndex(getDiagnostic(parser), index);
+            return status;
         }
+    }
 
-        if (!isEscapeCharacter(argument[1])) {
-            /* Short '-x' or '-abc' form. */
-            for (size_t i = 1; isOptionCharacter(argument[i]); ++i) {
-                status = parseOption(parser, &argument[i], true);
-                if (status)
-                    return status;
-            }
+    return status;
+}
+
+/* Copies unterminated last @argument of buffer into @result arena, so that handlers see terminated string. */
+static inline char *
+copyArgument(
+    cla_result_t *result,
+    char const *argument,
+    size_t length
+) {
+    char
+        *copy = cla_allocate(&result->arena, length + 1);
+
+    if (copy) {
+        memcpy(copy, argument, length);
+        copy[length] = '\0';
+    }
+
+    return copy;
+}
+
+static inline int
+parseBuffer(
+    cla_parser_t *parser,
+    char *cursor,
+    char *end
+) {
+    int
+        status = cla_noErrors;
+
+    parser->next = NULL;
+
+    /* First argument (binary name) is already skipped. */
+    for (size_t index = 1; cursor < end && !parser->isTerminated && !parser->next; ++index) {
+        char
+            *terminator = memchr(cursor, '\0', (size_t) (end - cursor));
+        size_t const
+            length = (size_t) ((terminator ? terminator : end) - cursor);
+        char
+            *argument = terminator
+                ? cursor
+                : copyArgument(parser->result, cursor, length);
+        token_t
+            token;
+
+        if (argument) {
+            tokenizeBounded(&token, argument, length);
+            status = parseArgument(parser, &token, 0);
         } else {
-            /* Long '--name' form. */
-            status = parseOption(parser, &argument[2], false);
-            if (status)
-                return status;
+            status = cla_outOfMemoryError;
         }
+
+        if (status) {
+            reportIndex(getDiagnostic(parser), index);
+            return status;
+        }
+
+        /* Skips the terminator, if any. */
+        cursor += length + 1;
     }
 
     return status;
@@ -198,3 +632,690 @@ cla_parseOptions(
 
     return cla_noErrors;
 }
+
+static inline int
+beginParse(
+    cla_schema_t const *schema,
+    cla_result_t *result
+) {
+    if (!result->arguments || !result->references || (result->argumentLengths && !result->decodedOptions))
+        /* Null @result storage. */
+        return result->status = cla_nullReferenceError;
+
+    /* Previous mappings are not referenced by new result. */
+    cla_releaseResult(result);
+
+    memset(result->references, 0,
+        cla_numberOfWords(schema->numberOfOptions) * sizeof *result->references);
+    if (result->argumentLengths)
+        memset(result->decodedOptions, 0,
+            cla_numberOfWords(schema->numberOfOptions) * sizeof *result->decodedOptions);
+
+    if (result->diagnostic)
+        memset(result->diagnostic, 0, sizeof *result->diagnostic);
+
+    result->schema = schema;
+    result->numberOfRequiredReferences = 0;
+    result->next = NULL;
+    result->isTerminated = false;
+    resetStatistics(result);
+
+    return cla_noErrors;
+}
+
+static inline cla_parser_t
+makeParser(
+    cla_schema_t const *schema,
+    cla_result_t *result
+) {
+    cla_parser_t
+        parser = {
+            .options = schema->options,
+            .numberOfOptions = schema->numberOfOptions,
+            .isLenient = schema->isLenient,
+            .schema = schema,
+            .result = result,
+        };
+
+    return parser;
+}
+
+/* Records options not given on command line from single pass over environment. */
+static inline int
+parseEnvironment(
+    cla_schema_t const *schema,
+    cla_result_t *result
+) {
+    cla_parser_t
+        parser = makeParser(schema, result);
+
+    for (char **entry = result->environment; *entry; ++entry) {
+        char
+            *delimiter = strchr(*entry, '=');
+        cla_option_t
+            *option;
+        token_t
+            token;
+        int
+            status;
+
+        if (!delimiter)
+            /* Malformed entry names no variable. */
+            continue;
+
+        option = findVariable(schema, result, *entry, (size_t) (delimiter - *entry));
+        if (!option || isReferencedIndex(result, (size_t) (option - schema->options)))
+            /* Variable is unrelated, or option was given on command line. */
+            continue;
+
+        token.name = *entry;
+        token.nameLength = (size_t) (delimiter - *entry);
+        token.value = delimiter + 1;
+        token.valueLength = strlen(token.value);
+
+        status = recordOption(&parser, option, &token, cla_environmentSource);
+        if (status) {
+            reportToken(result->diagnostic, option, token.value, token.valueLength);
+            reportOrigin(result->diagnostic, cla_environmentSource, *entry);
+            reportIndex(result->diagnostic, (size_t) (entry - result->environment) + 1);
+            return status;
+        }
+    }
+
+    return cla_noErrors;
+}
+
+static inline void
+reportLine(
+    cla_diagnostic_t *diagnostic,
+    char const *line,
+    size_t lineNumber
+) {
+    reportOrigin(diagnostic, cla_fileSource, line);
+    reportIndex(diagnostic, lineNumber);
+}
+
+/* Records options given neither on command line, nor in environment from single pass over configuration file. */
+static inline int
+parseConfiguration(
+    cla_schema_t const *schema,
+    cla_result_t *result
+) {
+    cla_parser_t
+        parser = makeParser(schema, result);
+    cla_mapping_t
+        *mapping;
+    char
+        *cursor,
+        *end;
+    size_t
+        lineNumber = 1;
+    int
+        status;
+
+    if (result->numberOfMappings == result->maximumNumberOfMappings)
+        /* No storage left for configuration mapping. */
+        return cla_outOfMemoryError;
+
+    mapping = &result->mappings[result->numberOfMappings];
+
+    status = cla_mapFile(mapping, result->configurationPath);
+    if (status) {
+        reportToken(result->diagnostic, NULL, result->configurationPath, strlen(result->configurationPath));
+        return status;
+    }
+
+    ++result->numberOfMappings;
+
+    cursor = mapping->address;
+    end = cursor + mapping->size;
+
+    /* Keys and values point into mapping, so no copies are made. */
+    for (;; ++lineNumber) {
+        char
+            *line = cursor;
+        cla_option_t
+            *option;
+        token_t
+            token;
+
+        status = splitSetting(&cursor, end, &token);
+        if (!token.name)
+            return status;
+
+        /* Skipped lines are left intact, so their newlines are still in place. */
+        for (char const *chr = line; chr < token.name; ++chr) {
+            if (*chr == '\n') {
+                ++lineNumber;
+                line = (char *) chr + 1;
+            }
+        }
+
+        if (status) {
+            reportToken(result->diagnostic, NULL, token.name, token.nameLength);
+            reportLine(result->diagnostic, line, lineNumber);
+            return status;
+        }
+
+        option = findOption(schema, result, token.name, token.nameLength);
+        if (!option) {
+            if (schema->isLenient)
+                continue;
+
+            reportUnknownOption(&parser, token.name, token.nameLength, false);
+            reportLine(result->diagnostic, line, lineNumber);
+            return cla_unknowOptionError;
+        }
+
+        if (isReferencedIndex(result, (size_t) (option - schema->options)))
+            /* Option was given on command line, in environment, or earlier in file. */
+            continue;
+
+        status = recordOption(&parser, option, &token, cla_fileSource);
+        if (status) {
+            reportToken(result->diagnostic, option,
+                token.value ? token.value : token.name, token.value ? token.valueLength : token.nameLength);
+            reportLine(result->diagnostic, line, lineNumber);
+            return status;
+        }
+    }
+}
+
+/* Records first required option which is not referenced. */
+static inline void
+reportMissingOption(
+    cla_schema_t const *schema,
+    cla_result_t *result
+) {
+    if (!result->diagnostic)
+        return;
+
+    for (size_t i = 0; i < schema->numberOfOptions; ++i) {
+        if (schema->options[i].isRequired && !isReferencedIndex(result, i)) {
+            result->diagnostic->option = &schema->options[i];
+            return;
+        }
+    }
+}
+
+static inline int
+endParse(
+    cla_schema_t const *schema,
+    cla_result_t *result,
+    int status
+) {
+    if (!status && !result->isTerminated && result->environment && schema->numberOfEnvironmentOptions)
+        /* Command line takes precedence, so environment fills remaining options only. */
+        status = parseEnvironment(schema, result);
+
+    if (!status && !result->isTerminated && result->configurationPath)
+        /* Configuration file fills options left by both. */
+        status = parseConfiguration(schema, result);
+
+    if (!status && result->numberOfRequiredReferences < schema->numberOfRequiredOptions) {
+        /* Some of required options were not referenced. */
+        status = cla_missingOptionError;
+        reportMissingOption(schema, result);
+    }
+
+    return result->status = status;
+}
+
+int
+cla_parse(
+    cla_schema_t const *schema,
+    cla_result_t *result,
+    int argc,
+    char **argv
+) {
+    uint64_t const
+        start = beginTiming();
+    int
+        status;
+
+    if (!schema || !result)
+        /* Null @schema, or @result. */
+        return cla_nullReferenceError;
+
+    if (!argv)
+        /* Null @argv, recorded so that batches see it. */
+        return result->status = cla_nullReferenceError;
+
+    status = beginParse(schema, result);
+    if (status)
+        return status;
+
+    if (argc > 1) {
+        cla_parser_t
+            parser = makeParser(schema, result);
+
+        /* Skips first argument (binary name). */
+        status = parseOptions(&parser, --argc, ++argv);
+
+        result->next = parser.next;
+        result->isTerminated = parser.isTerminated;
+    }
+
+    endTiming(result, start);
+
+    return endParse(schema, result, status);
+}
+
+int
+cla_parseBuffer(
+    cla_schema_t const *schema,
+    cla_result_t *result,
+    char const *buffer,
+    size_t length
+) {
+    uint64_t const
+        start = beginTiming();
+    char
+        *cursor = (char *) buffer,
+        *terminator;
+    int
+        status;
+
+    if (!schema || !result || (!buffer && length))
+        /* Null @schema, @result, or @buffer. */
+        return cla_nullReferenceError;
+
+    status = beginParse(schema, result);
+    if (status)
+        return status;
+
+    /* Skips first argument (binary name). */
+    terminator = length
+        ? memchr(cursor, '\0', length)
+        : NULL;
+
+    if (terminator) {
+        cla_parser_t
+            parser = makeParser(schema, result);
+
+        status = parseBuffer(&parser, terminator + 1, cursor + length);
+
+        result->next = parser.next;
+        result->isTerminated = parser.isTerminated;
+    }
+
+    endTiming(result, start);
+
+    return endParse(schema, result, status);
+}
+
+static inline bool
+isStreamStopped(
+    cla_stream_t const *stream
+) {
+    return stream->result->isTerminated || stream->result->next;
+}
+
+static inline int
+parseStreamArgument(
+    cla_stream_t *stream,
+    char *argument,
+    size_t length
+) {
+    cla_result_t
+        *result = stream->result;
+    cla_parser_t
+        parser = makeParser(stream->schema, result);
+    token_t
+        token;
+    int
+        status;
+
+    if (!length)
+        /* Blank arguments, e.g. trailing newlines, are skipped. */
+        return cla_noErrors;
+
+    tokenizeBounded(&token, argument, length);
+    status = parseArgument(&parser, &token, 0);
+
+    result->next = parser.next;
+    result->isTerminated = parser.isTerminated;
+
+    return status;
+}
+
+static inline int
+appendToStream(
+    cla_stream_t *stream,
+    char const *bytes,
+    size_t length
+) {
+    if (stream->length + length >= stream->bufferSize)
+        /* Argument and its terminator do not fit. */
+        return cla_outOfMemoryError;
+
+    memcpy(&stream->buffer[stream->length], bytes, length);
+    stream->length += length;
+    stream->buffer[stream->length] = '\0';
+
+    return cla_noErrors;
+}
+
+int
+cla_beginStream(
+    cla_stream_t *stream
+) {
+    if (!stream || !stream->schema || !stream->result)
+        /* Null @stream, or its schema or result. */
+        return cla_nullReferenceError;
+
+    if (stream->result->argumentLengths)
+        /* Recorded arguments would point into reused chunks. */
+        return stream->status = cla_illegalInputError;
+
+    stream->length = 0;
+
+    return stream->status = beginParse(stream->schema, stream->result);
+}
+
+int
+cla_feed(
+    cla_stream_t *stream,
+    char const *chunk,
+    size_t length
+) {
+    uint64_t const
+        start = beginTiming();
+    char const
+        *cursor = chunk,
+        *end = chunk + length;
+    int
+        status = cla_noErrors;
+
+    if (!stream || !stream->schema || !stream->result || (!chunk && length))
+        /* Null @stream, its schema or result, or @chunk. */
+        return cla_nullReferenceError;
+
+    if (stream->status)
+        /* Stream has already failed. */
+        return stream->status;
+
+    while (cursor < end && !status && !isStreamStopped(stream)) {
+        char const
+            *separator = memchr(cursor, stream->separator, (size_t) (end - cursor));
+        size_t const
+            argumentLength = (size_t) ((separator ? separator : end) - cursor);
+
+        if (!separator) {
+            /* Argument continues in next chunk. */
+            status = appendToStream(stream, cursor, argumentLength);
+            break;
+        }
+
+        if (stream->length || stream->separator) {
+            /* Argument is assembled and terminated in buffer. */
+            status = appendToStream(stream, cursor, argumentLength);
+            if (!status)
+                status = parseStreamArgument(stream, stream->buffer, stream->length);
+
+            stream->length = 0;
+        } else {
+            /* Argument lies within chunk and is terminated by separator itself. */
+            status = parseStreamArgument(stream, (char *) cursor, argumentLength);
+        }
+
+        cursor = separator + 1;
+    }
+
+    if (isStreamStopped(stream))
+        /* Remaining arguments are skipped. */
+        stream->length = 0;
+
+    endTiming(stream->result, start);
+
+    return stream->status = status;
+}
+
+int
+cla_finish(
+    cla_stream_t *stream
+) {
+    uint64_t const
+        start = beginTiming();
+    int
+        status;
+
+    if (!stream || !stream->schema || !stream->result)
+        /* Null @stream, or its schema or result. */
+        return cla_nullReferenceError;
+
+    status = stream->status;
+
+    if (!status && stream->length && !isStreamStopped(stream))
+        /* Last argument has no trailing separator. */
+        status = parseStreamArgument(stream, stream->buffer, stream->length);
+
+    stream->length = 0;
+
+    endTiming(stream->result, start);
+
+    return stream->status = endParse(stream->schema, stream->result, status);
+}
+
+void
+cla_releaseResult(
+    cla_result_t *result
+) {
+    if (!result)
+        return;
+
+    for (size_t i = 0; i < result->numberOfMappings; ++i)
+        cla_unmapFile(&result->mappings[i]);
+
+    result->numberOfMappings = 0;
+
+    for (cla_list_t *list = result->lists, *next; list; list = next) {
+        next = list->next;
+        *list = (cla_list_t) {
+            .separator = list->separator,
+        };
+    }
+
+    result->lists = NULL;
+    cla_resetArena(&result->arena);
+}
+
+/* Decodes argument recorded by lazy parse, memoizing success. */
+static inline int
+decodeRecordedOption(
+    cla_schema_t const *schema,
+    cla_result_t *result,
+    cla_option_t const *option,
+    size_t index
+) {
+    cla_parser_t
+        parser = makeParser(schema, result);
+    int const
+        status = decodeOption(&parser, option, index, result->arguments[index], result->argumentLengths[index]);
+
+    if (!status)
+        result->decodedOptions[index / 64] |= (uint64_t) 1 << (index % 64);
+
+    return status;
+}
+
+int
+cla_decodeArgument(
+    cla_schema_t const *schema,
+    cla_result_t *result,
+    size_t index
+) {
+    cla_parser_t
+        parser = makeParser(schema, result);
+    char
+        *argument = result->arguments[index];
+
+    return decodeOption(&parser, &schema->options[index], index, argument, argument ? strlen(argument) : 0);
+}
+
+int
+cla_get(
+    cla_result_t *result,
+    cla_option_t const *option
+) {
+    cla_schema_t const
+        *schema;
+    size_t
+        index;
+
+    if (!result || !option || !result->schema)
+        /* Null @result, or @option, or result was not parsed. */
+        return cla_nullReferenceError;
+
+    schema = result->schema;
+
+    if (option < schema->options || option >= schema->options + schema->numberOfOptions)
+        /* @option belongs to another schema. */
+        return cla_illegalInputError;
+
+    index = (size_t) (option - schema->options);
+
+    if (!result->argumentLengths || !option->handler ||
+        !isReferencedIndex(result, index) || isDecodedIndex(result, index))
+        /* Value was decoded during parse, or earlier call, or there is nothing to decode. */
+        return cla_noErrors;
+
+    return decodeRecordedOption(schema, result, option, index);
+}
+
+/* Checks whether arguments recorded for option at @index differ between lazy results. */
+static inline bool
+isChangedIndex(
+    cla_result_t const *previous,
+    cla_result_t const *result,
+    size_t index
+) {
+    char const
+        *before = previous->arguments[index],
+        *after = result->arguments[index];
+    size_t const
+        length = result->argumentLengths[index];
+
+    if (!before || !after)
+        /* Flag form, e.g. '--verbose', differs from any value, even empty one. */
+        return before != after;
+
+    return previous->argumentLengths[index] != length || memcmp(before, after, length);
+}
+
+/* Zero-fills holder of option at @index, which reload no longer references, when its size is known. */
+static inline void
+resetValue(
+    cla_schema_t const *schema,
+    cla_result_t const *result,
+    size_t index
+) {
+    cla_option_t const
+        *option = &schema->options[index];
+    void
+        *holder = result->values
+            ? result->values[index]
+            : option->valuePtr;
+
+    if (option->valueSize && holder)
+        memset(holder, 0, option->valueSize);
+}
+
+int
+cla_reparse(
+    cla_schema_t const *schema,
+    cla_result_t const *previous,
+    cla_result_t *result,
+    int argc,
+    char **argv,
+    uint64_t *changedOptions
+) {
+    size_t const
+        numberOfWords = cla_numberOfWords(schema ? schema->numberOfOptions : 0);
+    int
+        status;
+
+    if (!schema || !result || !argv || !changedOptions)
+        /* Null @schema, @result, @argv, or @changedOptions. */
+        return cla_nullReferenceError;
+
+    /* Nothing counts as changed, unless reload succeeds. */
+    memset(changedOptions, 0, numberOfWords * sizeof *changedOptions);
+
+    if (!result->argumentLengths || result == previous ||
+        (previous && (previous->schema != schema || !previous->argumentLengths)))
+        /* Arguments could not be compared. */
+        return cla_illegalInputError;
+
+    /* Records new arguments without running handlers. */
+    status = cla_parse(schema, result, argc, argv);
+    if (status)
+        return status;
+
+    for (size_t word = 0; word < numberOfWords; ++word) {
+        uint64_t const
+            before = previous ? previous->references[word] : 0,
+            after = result->references[word];
+        uint64_t
+            changes = before ^ after,
+            common = before & after;
+
+        /* Only options referenced by both results need their arguments compared. */
+        for (; common; common &= common - 1) {
+            size_t const
+                index = word * 64 + (size_t) countTrailingZeros(common);
+
+            if (isChangedIndex(previous, result, index))
+                changes |= (uint64_t) 1 << (index % 64);
+            else
+                result->decodedOptions[word] |= previous->decodedOptions[word] & (uint64_t) 1 << (index % 64);
+        }
+
+        changedOptions[word] = changes;
+
+        /* Added and changed options are decoded at once, removed ones have nothing to decode. */
+        for (changes &= after; changes; changes &= changes - 1) {
+            size_t const
+                index = word * 64 + (size_t) countTrailingZeros(changes);
+            cla_option_t const
+                *option = &schema->options[index];
+
+            if (!option->handler)
+                continue;
+
+            status = decodeRecordedOption(schema, result, option, index);
+            if (status) {
+                /* Partial list would not tell which handlers ran. */
+                memset(changedOptions, 0, numberOfWords * sizeof *changedOptions);
+                return result->status = status;
+            }
+        }
+    }
+
+    /* Removed options are reset once reload is known to succeed. */
+    for (size_t word = 0; word < numberOfWords; ++word) {
+        for (uint64_t removed = changedOptions[word] & ~result->references[word]; removed; removed &= removed - 1)
+            resetValue(schema, result, word * 64 + (size_t) countTrailingZeros(removed));
+    }
+
+    return cla_noErrors;
+}
+
+void
+cla_tokenize(
+    cla_token_t *token,
+    char *argument
+) {
+    if (token && argument)
+        tokenize(token, argument);
+}
+
+bool
+cla_isReferenced(
+    cla_result_t const *result,
+    size_t index
+) {
+    return result && result->references
+        ? isReferencedIndex(result, index)
+        : false;
+}
@@ -0,0 +1,14 @@
+#pragma once
+
+#include <clarum/clarum.h>
+
+/*
+ * Runs handler of option at @index on its terminated argument recorded in @result,
+ * as parser would, for callers which restore results without parsing.
+ */
+int
+cla_decodeArgument(
+    cla_schema_t const *schema,
+    cla_result_t *result,
+    size_t index
+);
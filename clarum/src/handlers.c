@@ -1,34 +1,168 @@
+#include "arena.h"
+#include "decimal.h"
+#include "schema.h"
 #include <clarum/clarum.h>
 #include <string.h>
-#include <ctype.h>
 #include <stdint.h>
-#include <math.h>
 
-static inline int
-decodeBooleanValue(
-    bool *value,
-    char const *str
+static inline bool
+isLiteral(
+    char const *str,
+    size_t length,
+    char const *literal
 ) {
-    if (!strcmp(str, "true") || !strcmp(str, "yes") ||
-        !strcmp(str, "on") || !strcmp(str, "1")) {
-        *value = true;
-        return cla_noErrors;
+    /* Compares lengths first, as @str may hold NUL, e.g. buffer argument. */
+    return strlen(literal) == length && !memcmp(str, literal, length);
+}
+
+static inline size_t
+getChoiceSlot(
+    cla_choice_t const *choice,
+    uint32_t hash
+) {
+    /* Multiplicative hashing, top bits select slot. */
+    return (uint32_t) (hash * choice->seed) >> (32 - choice->numberOfBits);
+}
+
+static inline bool
+placeKeywords(
+    cla_choice_t *choice,
+    uint32_t const *hashes
+) {
+    memset(choice->slots, 0, sizeof choice->slots);
+
+    for (size_t i = 0; i < choice->numberOfKeywords; ++i) {
+        size_t const
+            slot = getChoiceSlot(choice, hashes[i]);
+
+        if (choice->slots[slot])
+            /* Current seed does not separate keywords. */
+            return false;
+
+        choice->slots[slot] = (uint8_t) (i + 1);
     }
 
-    if (!strcmp(str, "false") || !strcmp(str, "no") ||
-        !strcmp(str, "off") || !strcmp(str, "0")) {
-        *value = false;
-        return cla_noErrors;
+    return true;
+}
+
+int
+cla_compileChoice(
+    cla_choice_t *choice
+) {
+    /* Seeds tried per table size before table is doubled. */
+    unsigned const
+        maximumNumberOfSeeds = 1024,
+        maximumNumberOfBits = 8;
+    uint32_t
+        hashes[cla_maximumNumberOfKeywords];
+
+    if (!choice || (!choice->keywords && choice->numberOfKeywords))
+        /* No keywords provided. */
+        return cla_nullReferenceError;
+
+    if (choice->numberOfKeywords > cla_maximumNumberOfKeywords)
+        /* Keywords would not fit collision-free table. */
+        return cla_illegalInputError;
+
+    for (size_t i = 0; i < choice->numberOfKeywords; ++i) {
+        char const
+            *name = choice->keywords[i].name;
+
+        if (!name)
+            /* Keyword has no name. */
+            return cla_nullReferenceError;
+
+        for (size_t j = 0; j < i; ++j)
+            if (!strcmp(choice->keywords[j].name, name))
+                /* Duplicate keyword. */
+                return cla_illegalInputError;
+
+        hashes[i] = hashKey(name, strlen(name));
     }
 
+    /* Starts at load factor of one half at most. */
+    for (choice->numberOfBits = 1; (1u << choice->numberOfBits) < 2 * choice->numberOfKeywords; ++choice->numberOfBits);
+
+    for (; choice->numberOfBits <= maximumNumberOfBits; ++choice->numberOfBits)
+        for (unsigned i = 0; i < maximumNumberOfSeeds; ++i) {
+            /* Odd multipliers keep hashes distinct. */
+            choice->seed = (2 * i + 1) * 0x9E3779B9u;
+
+            if (placeKeywords(choice, hashes))
+                return cla_noErrors;
+        }
+
+    /* Keywords collide under every seed. */
     return cla_illegalInputError;
 }
 
+static inline int
+decodeChoice(
+    int *value,
+    cla_choice_t const *choice,
+    char const *str,
+    size_t length
+) {
+    size_t const
+        index = choice->slots[getChoiceSlot(choice, hashKey(str, length))];
+
+    if (!index || !keyEquals(choice->keywords[index - 1].name, str, length))
+        /* @str matches no keyword. */
+        return cla_illegalInputError;
+
+    *value = choice->keywords[index - 1].value;
+    return cla_noErrors;
+}
+
+int
+cla_choiceHandler(
+    cla_parser_t *parser,
+    cla_option_t *option
+) {
+    int
+        value,
+        status;
+
+    (void) parser;
+
+    if (!option->argument || !option->valuePtr || !option->context)
+        /* No argument, value holder, or keywords provided. */
+        return cla_nullReferenceError;
+
+    status = decodeChoice(&value, option->context, option->argument, option->argumentLength);
+    if (!status)
+        *((int *) option->valuePtr) = value;
+
+    return status;
+}
+
+static cla_keyword_t const
+    booleanKeywords[] = {
+        {"true", true}, {"yes", true}, {"on", true}, {"1", true},
+        {"false", false}, {"no", false}, {"off", false}, {"0", false},
+    };
+
+/* Precomputed by cla_compileChoice(); must be refreshed whenever keyword hashing changes. */
+static cla_choice_t const
+    booleanChoice = {
+        .keywords = booleanKeywords,
+        .numberOfKeywords = sizeof booleanKeywords / sizeof *booleanKeywords,
+        .seed = 0x9E3779B9u,
+        .numberOfBits = 4,
+        .slots = {
+            [2] = 8, [3] = 6, [4] = 5, [5] = 7, [6] = 4, [7] = 1, [11] = 3, [14] = 2,
+        },
+    };
+
 int
 cla_booleanHandler(
     cla_parser_t *parser,
     cla_option_t *option
 ) {
+    int
+        value,
+        status;
+
     (void) parser;
 
     if (!option->valuePtr)
@@ -41,72 +175,789 @@ cla_booleanHandler(
         return cla_noErrors;
     }
 
-    return decodeBooleanValue(option->valuePtr, option->argument);
+    status = decodeChoice(&value, &booleanChoice, option->argument, option->argumentLength);
+    if (!status)
+        *((bool *) option->valuePtr) = value;
+
+    return status;
 }
 
-static inline size_t
-parseDecimalCharacter(
-    char decimalCharacter
+static inline bool
+isDecimalDigit(
+    char chr
 ) {
-    const size_t
-        invalidValue = 10;
+    return chr >= '0' && chr <= '9';
+}
+
+static inline unsigned
+decodeHexadecimalDigit(
+    char chr
+) {
+    unsigned const
+        invalidValue = 16;
 
-    if (isdigit(decimalCharacter))
-        return (size_t) (decimalCharacter - '0');
+    if (isDecimalDigit(chr))
+        return (unsigned) (chr - '0');
+
+    if (chr >= 'a' && chr <= 'f')
+        return (unsigned) (chr - 'a' + 10);
+
+    if (chr >= 'A' && chr <= 'F')
+        return (unsigned) (chr - 'A' + 10);
 
     return invalidValue;
 }
 
-static inline int
-parseIntegerFromDecimalString(
-    size_t *value,
+static inline uint64_t
+loadWord(
     char const *str
 ) {
-    const size_t
-        maximumStringLength = (size_t) ceil(log10(SIZE_MAX)) + 1;
+    uint64_t
+        word;
 
-    if (!value || !str)
-        return cla_nullReferenceError;
+    memcpy(&word, str, sizeof word);
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    /* Keeps first character in the lowest byte. */
+    word = __builtin_bswap64(word);
+#endif
+
+    return word;
+}
+
+static inline bool
+isEightDigits(
+    uint64_t word
+) {
+    /* Every byte shall be within ['0', '9'], i.e. 0x3? both before and after adding 6. */
+    return (((word & 0xF0F0F0F0F0F0F0F0u) |
+        (((word + 0x0606060606060606u) & 0xF0F0F0F0F0F0F0F0u) >> 4)) == 0x3333333333333333u);
+}
+
+static inline uint32_t
+decodeEightDigits(
+    uint64_t word
+) {
+    uint64_t const
+        mask = 0x000000FF000000FFu,
+        lowMultiplier = 100 + (1000000ull << 32),
+        highMultiplier = 1 + (10000ull << 32);
+
+    /* Combines adjacent digits pairwise: 1-digit, then 2-digit, then 4-digit lanes. */
+    word -= 0x3030303030303030u;
+    word = word * 10 + (word >> 8);
 
-    if (strlen(str) > maximumStringLength)
-        /* @str is too long to be decimal string. */
+    return (uint32_t) (((word & mask) * lowMultiplier + ((word >> 16) & mask) * highMultiplier) >> 32);
+}
+
+static inline int
+decodeDecimal(
+    uint64_t *value,
+    char const *str,
+    size_t length
+) {
+    /* Number of digits in UINT64_MAX. */
+    size_t const
+        maximumNumberOfDigits = 20;
+    uint64_t
+        result = 0;
+    size_t
+        i = 0;
+
+    if (!length)
+        /* @str has no digits. */
         return cla_illegalInputError;
 
-    /* Resets holder value. */
-    *value = 0;
+    /* Leading zeros do not count towards overflow. */
+    for (; length > 1 && str[0] == '0'; ++str, --length);
 
-    for (; *str; ++str) {
-        size_t const
-            temporary = *value,
-            digit = parseDecimalCharacter(*str);
+    if (length > maximumNumberOfDigits)
+        /* @str is either non-decimal or too long to be stored. */
+        return cla_illegalInputError;
+
+    /* At most 16 digits are taken by blocks, which cannot overflow. */
+    for (; i + 8 <= length; i += 8) {
+        uint64_t const
+            word = loadWord(&str[i]);
 
-        if (digit > 9)
+        if (!isEightDigits(word))
             /* @str contains non-decimal character. */
             return cla_illegalInputError;
 
-        *value *= 10;
-        *value += digit;
+        result = result * 100000000 + decodeEightDigits(word);
+    }
+
+    for (; i < length; ++i) {
+        unsigned const
+            digit = (unsigned) (str[i] - '0');
 
-        if (temporary >= *value)
-            /* @str represents integer which cannot be stored (incurs overflow). */
+        if (!isDecimalDigit(str[i]))
+            /* @str contains non-decimal character. */
             return cla_illegalInputError;
+
+        if (result > (UINT64_MAX - digit) / 10)
+            /* @str represents integer which cannot be stored. */
+            return cla_illegalInputError;
+
+        result = result * 10 + digit;
     }
 
+    *value = result;
     return cla_noErrors;
 }
 
+static inline int
+decodeHexadecimal(
+    uint64_t *value,
+    char const *str,
+    size_t length
+) {
+    /* Number of hexadecimal digits in UINT64_MAX. */
+    size_t const
+        maximumNumberOfDigits = 16;
+    uint64_t
+        result = 0;
+
+    if (!length)
+        /* @str has no digits. */
+        return cla_illegalInputError;
+
+    /* Leading zeros do not count towards overflow. */
+    for (; length > 1 && str[0] == '0'; ++str, --length);
+
+    if (length > maximumNumberOfDigits)
+        /* @str is either non-hexadecimal or too long to be stored. */
+        return cla_illegalInputError;
+
+    for (size_t i = 0; i < length; ++i) {
+        unsigned const
+            digit = decodeHexadecimalDigit(str[i]);
+
+        if (digit > 15)
+            /* @str contains non-hexadecimal character. */
+            return cla_illegalInputError;
+
+        result = result << 4 | digit;
+    }
+
+    *value = result;
+    return cla_noErrors;
+}
+
+static inline bool
+isHexadecimalPrefix(
+    char const *str,
+    size_t length
+) {
+    return length > 2 && str[0] == '0' && (str[1] == 'x' || str[1] == 'X');
+}
+
+static inline int
+decodeMagnitude(
+    uint64_t *value,
+    char const *str,
+    size_t length
+) {
+    return isHexadecimalPrefix(str, length)
+        ? decodeHexadecimal(value, &str[2], length - 2)
+        : decodeDecimal(value, str, length);
+}
+
+static inline int
+decodeUnsigned(
+    uint64_t *value,
+    char const *str,
+    size_t length,
+    uint64_t maximum
+) {
+    int
+        status;
+
+    if (length && str[0] == '+')
+        ++str, --length;
+
+    status = decodeMagnitude(value, str, length);
+    if (status)
+        return status;
+
+    return *value > maximum
+        /* Value does not fit target type. */
+        ? cla_illegalInputError
+        : cla_noErrors;
+}
+
+static inline int
+decodeSigned(
+    int64_t *value,
+    char const *str,
+    size_t length,
+    int64_t minimum,
+    int64_t maximum
+) {
+    bool
+        isNegative = false;
+    uint64_t
+        magnitude;
+    int
+        status;
+
+    if (length && (str[0] == '-' || str[0] == '+')) {
+        isNegative = str[0] == '-';
+        ++str, --length;
+    }
+
+    status = decodeMagnitude(&magnitude, str, length);
+    if (status)
+        return status;
+
+    if (isNegative) {
+        if (magnitude > (uint64_t) -(minimum + 1) + 1)
+            /* Value does not fit target type. */
+            return cla_illegalInputError;
+
+        /* Avoids negating minimum value of int64_t. */
+        *value = magnitude
+            ? -(int64_t) (magnitude - 1) - 1
+            : 0;
+    } else {
+        if (magnitude > (uint64_t) maximum)
+            /* Value does not fit target type. */
+            return cla_illegalInputError;
+
+        *value = (int64_t) magnitude;
+    }
+
+    return cla_noErrors;
+}
+
+static inline size_t
+getNumberOfDigits(
+    char const *str,
+    size_t length
+) {
+    size_t
+        i = 0;
+
+    if (isHexadecimalPrefix(str, length))
+        /* Hexadecimal values take no suffix. */
+        return length;
+
+    if (length && str[0] == '+')
+        ++i;
+
+    while (i < length && isDecimalDigit(str[i]))
+        ++i;
+
+    return i;
+}
+
+static inline int
+decodeScaled(
+    uint64_t *value,
+    char const *str,
+    size_t length,
+    uint64_t multiplier
+) {
+    int const
+        status = decodeUnsigned(value, str, length, UINT64_MAX);
+
+    if (status)
+        return status;
+
+    if (*value > UINT64_MAX / multiplier)
+        /* Scaled value cannot be stored. */
+        return cla_illegalInputError;
+
+    *value *= multiplier;
+    return cla_noErrors;
+}
+
+static inline uint64_t
+getSizeMultiplier(
+    char const *suffix,
+    size_t length
+) {
+    static char const
+        prefixes[] = "KMGTPE";
+    char const
+        *prefix;
+    uint64_t
+        multiplier = 1;
+
+    if (!length || isLiteral(suffix, length, "B"))
+        return 1;
+
+    prefix = memchr(prefixes, suffix[0] == 'k' ? 'K' : suffix[0], sizeof prefixes - 1);
+    if (!prefix)
+        /* Unknown suffix. */
+        return 0;
+
+    for (ptrdiff_t i = 0; i <= prefix - prefixes; ++i) {
+        /* 'K' and 'KiB' are binary, 'KB' is decimal. */
+        if (length == 1 || isLiteral(&suffix[1], length - 1, "iB"))
+            multiplier <<= 10;
+        else if (isLiteral(&suffix[1], length - 1, "B"))
+            multiplier *= 1000;
+        else
+            return 0;
+    }
+
+    return multiplier;
+}
+
+static inline uint64_t
+getDurationMultiplier(
+    char const *suffix,
+    size_t length
+) {
+    if (isLiteral(suffix, length, "ns"))
+        return 1;
+
+    if (isLiteral(suffix, length, "us"))
+        return 1000;
+
+    if (isLiteral(suffix, length, "ms"))
+        return 1000000;
+
+    if (!length || isLiteral(suffix, length, "s"))
+        return 1000000000;
+
+    if (isLiteral(suffix, length, "m") || isLiteral(suffix, length, "min"))
+        return 60 * 1000000000ull;
+
+    if (isLiteral(suffix, length, "h"))
+        return 60 * 60 * 1000000000ull;
+
+    if (isLiteral(suffix, length, "d"))
+        return 24 * 60 * 60 * 1000000000ull;
+
+    /* Unknown suffix. */
+    return 0;
+}
+
+static inline int
+checkOption(
+    cla_option_t const *option
+) {
+    return option->argument && option->valuePtr
+        ? cla_noErrors
+        : cla_nullReferenceError;
+}
+
 int
 cla_integerHandler(
     cla_parser_t *parser,
     cla_option_t *option
 ) {
+    uint64_t
+        value;
+    int
+        status = checkOption(option);
+
     (void) parser;
 
-    return option->argument
-        ? parseIntegerFromDecimalString(option->valuePtr, option->argument)
+    if (!status)
+        status = decodeUnsigned(&value, option->argument, option->argumentLength, SIZE_MAX);
+
+    if (!status)
+        *((size_t *) option->valuePtr) = (size_t) value;
+
+    return status;
+}
+
+int
+cla_int32Handler(
+    cla_parser_t *parser,
+    cla_option_t *option
+) {
+    int64_t
+        value;
+    int
+        status = checkOption(option);
+
+    (void) parser;
+
+    if (!status)
+        status = decodeSigned(&value, option->argument, option->argumentLength, INT32_MIN, INT32_MAX);
+
+    if (!status)
+        *((int32_t *) option->valuePtr) = (int32_t) value;
+
+    return status;
+}
+
+int
+cla_int64Handler(
+    cla_parser_t *parser,
+    cla_option_t *option
+) {
+    int64_t
+        value;
+    int
+        status = checkOption(option);
+
+    (void) parser;
+
+    if (!status)
+        status = decodeSigned(&value, option->argument, option->argumentLength, INT64_MIN, INT64_MAX);
+
+    if (!status)
+        *((int64_t *) option->valuePtr) = value;
+
+    return status;
+}
+
+int
+cla_uint32Handler(
+    cla_parser_t *parser,
+    cla_option_t *option
+) {
+    uint64_t
+        value;
+    int
+        status = checkOption(option);
+
+    (void) parser;
+
+    if (!status)
+        status = decodeUnsigned(&value, option->argument, option->argumentLength, UINT32_MAX);
+
+    if (!status)
+        *((uint32_t *) option->valuePtr) = (uint32_t) value;
+
+    return status;
+}
+
+int
+cla_uint64Handler(
+    cla_parser_t *parser,
+    cla_option_t *option
+) {
+    uint64_t
+        value;
+    int
+        status = checkOption(option);
+
+    (void) parser;
+
+    if (!status)
+        status = decodeUnsigned(&value, option->argument, option->argumentLength, UINT64_MAX);
+
+    if (!status)
+        *((uint64_t *) option->valuePtr) = value;
+
+    return status;
+}
+
+int
+cla_sizeHandler(
+    cla_parser_t *parser,
+    cla_option_t *option
+) {
+    uint64_t
+        value,
+        multiplier;
+    size_t
+        numberOfDigits;
+    int
+        status = checkOption(option);
+
+    (void) parser;
+
+    if (status)
+        return status;
+
+    numberOfDigits = getNumberOfDigits(option->argument, option->argumentLength);
+    multiplier = getSizeMultiplier(&option->argument[numberOfDigits], option->argumentLength - numberOfDigits);
+
+    if (!multiplier)
+        /* Unknown suffix. */
+        return cla_illegalInputError;
+
+    status = decodeScaled(&value, option->argument, numberOfDigits, multiplier);
+    if (!status)
+        *((uint64_t *) option->valuePtr) = value;
+
+    return status;
+}
+
+int
+cla_durationHandler(
+    cla_parser_t *parser,
+    cla_option_t *option
+) {
+    uint64_t
+        value,
+        multiplier;
+    size_t
+        numberOfDigits;
+    int
+        status = checkOption(option);
+
+    (void) parser;
+
+    if (status)
+        return status;
+
+    numberOfDigits = getNumberOfDigits(option->argument, option->argumentLength);
+    multiplier = getDurationMultiplier(&option->argument[numberOfDigits], option->argumentLength - numberOfDigits);
+
+    if (!multiplier)
+        /* Unknown suffix. */
+        return cla_illegalInputError;
+
+    status = decodeScaled(&value, option->argument, numberOfDigits, multiplier);
+    if (!status)
+        *((uint64_t *) option->valuePtr) = value;
+
+    return status;
+}
+
+int
+cla_doubleHandler(
+    cla_parser_t *parser,
+    cla_option_t *option
+) {
+    int
+        status = checkOption(option);
+
+    (void) parser;
+
+    if (!status)
+        status = cla_decodeDouble(option->valuePtr, option->argument, option->argumentLength);
+
+    return status;
+}
+
+int
+cla_floatHandler(
+    cla_parser_t *parser,
+    cla_option_t *option
+) {
+    int
+        status = checkOption(option);
+
+    (void) parser;
+
+    if (!status)
+        status = cla_decodeFloat(option->valuePtr, option->argument, option->argumentLength);
+
+    return status;
+}
+
+static inline int
+checkListOption(
+    cla_parser_t const *parser,
+    cla_option_t const *option
+) {
+    return parser && parser->result && option->argument && option->valuePtr
+        ? cla_noErrors
         : cla_nullReferenceError;
 }
 
+static inline size_t
+getPartLength(
+    char const *str,
+    size_t length,
+    char separator
+) {
+    char const
+        *end = separator
+            ? memchr(str, separator, length)
+            : NULL;
+
+    return end
+        ? (size_t) (end - str)
+        : length;
+}
+
+static inline void *
+appendItem(
+    cla_result_t *result,
+    cla_list_t *list,
+    size_t itemSize
+) {
+    if (list->numberOfItems == list->capacity) {
+        size_t const
+            capacity = list->capacity ? 2 * list->capacity : 8;
+        void
+            *items = cla_reallocate(&result->arena, list->items, list->capacity * itemSize, capacity * itemSize);
+
+        if (!items)
+            return NULL;
+
+        if (!list->items) {
+            /* First item of this parse; list is emptied on release. */
+            list->next = result->lists;
+            result->lists = list;
+        }
+
+        list->items = items;
+        list->capacity = capacity;
+    }
+
+    return (char *) list->items + list->numberOfItems++ * itemSize;
+}
+
+int
+cla_listHandler(
+    cla_parser_t *parser,
+    cla_option_t *option
+) {
+    cla_list_t
+        *list = option->valuePtr;
+    char const
+        *str = option->argument;
+    size_t
+        length = option->argumentLength;
+    int const
+        status = checkListOption(parser, option);
+
+    if (status)
+        return status;
+
+    for (;;) {
+        size_t const
+            partLength = getPartLength(str, length, list->separator);
+        cla_slice_t
+            *slice = appendItem(parser->result, list, sizeof *slice);
+
+        if (!slice)
+            return cla_outOfMemoryError;
+
+        *slice = (cla_slice_t) {
+            .data = str,
+            .length = partLength,
+        };
+
+        if (partLength == length)
+            return cla_noErrors;
+
+        /* Skips separator. */
+        str += partLength + 1;
+        length -= partLength + 1;
+    }
+}
+
+static inline int
+appendInteger(
+    cla_result_t *result,
+    cla_list_t *list,
+    char const *str,
+    size_t length,
+    size_t itemSize,
+    bool isSigned
+) {
+    void
+        *item;
+    int
+        status;
+
+    if (isSigned) {
+        int64_t
+            value;
+
+        status = itemSize == sizeof(int32_t)
+            ? decodeSigned(&value, str, length, INT32_MIN, INT32_MAX)
+            : decodeSigned(&value, str, length, INT64_MIN, INT64_MAX);
+
+        if (status)
+            return status;
+
+        item = appendItem(result, list, itemSize);
+        if (!item)
+            return cla_outOfMemoryError;
+
+        if (itemSize == sizeof(int32_t))
+            *((int32_t *) item) = (int32_t) value;
+        else
+            *((int64_t *) item) = value;
+    } else {
+        uint64_t
+            value;
+
+        status = decodeUnsigned(&value, str, length, itemSize == sizeof(uint32_t) ? UINT32_MAX : UINT64_MAX);
+        if (status)
+            return status;
+
+        item = appendItem(result, list, itemSize);
+        if (!item)
+            return cla_outOfMemoryError;
+
+        if (itemSize == sizeof(uint32_t))
+            *((uint32_t *) item) = (uint32_t) value;
+        else
+            *((uint64_t *) item) = value;
+    }
+
+    return cla_noErrors;
+}
+
+static inline int
+appendIntegers(
+    cla_parser_t *parser,
+    cla_option_t *option,
+    size_t itemSize,
+    bool isSigned
+) {
+    cla_list_t
+        *list = option->valuePtr;
+    char const
+        *str = option->argument;
+    size_t
+        length = option->argumentLength;
+    int
+        status = checkListOption(parser, option);
+
+    while (!status) {
+        size_t const
+            partLength = getPartLength(str, length, list->separator);
+
+        status = appendInteger(parser->result, list, str, partLength, itemSize, isSigned);
+
+        if (partLength == length)
+            break;
+
+        /* Skips separator. */
+        str += partLength + 1;
+        length -= partLength + 1;
+    }
+
+    return status;
+}
+
+int
+cla_int32ListHandler(
+    cla_parser_t *parser,
+    cla_option_t *option
+) {
+    return appendIntegers(parser, option, sizeof(int32_t), true);
+}
+
+int
+cla_int64ListHandler(
+    cla_parser_t *parser,
+    cla_option_t *option
+) {
+    return appendIntegers(parser, option, sizeof(int64_t), true);
+}
+
+int
+cla_uint32ListHandler(
+    cla_parser_t *parser,
+    cla_option_t *option
+) {
+    return appendIntegers(parser, option, sizeof(uint32_t), false);
+}
+
+int
+cla_uint64ListHandler(
+    cla_parser_t *parser,
+    cla_option_t *option
+) {
+    return appendIntegers(parser, option, sizeof(uint64_t), false);
+}
+
 int
 cla_stringHandler(
     cla_parser_t *parser,
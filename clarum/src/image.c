@@ -0,0 +1,167 @@
+#include "schema.h"
+
+enum {
+    /* Reads as 'clas' in little-endian memory, and differently with other byte order. */
+    imageMagic = 0x73616C63,
+};
+
+/* Represents fixed head of schema image, which is followed by slots. */
+typedef
+    struct header_t
+    header_t;
+
+struct header_t {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t fingerprint;
+    uint64_t numberOfOptions;
+    uint64_t numberOfSlots;
+    uint64_t numberOfRequiredOptions;
+    uint64_t numberOfEnvironmentOptions;
+    uint32_t tags[256];
+};
+
+static inline uint64_t
+mixFingerprint(
+    uint64_t fingerprint,
+    uint64_t value
+) {
+    fingerprint = (fingerprint ^ value) * 0xBF58476D1CE4E5B9u;
+    return fingerprint ^ fingerprint >> 31;
+}
+
+/* Digests @key byte by byte, so that neither its length, nor copies are needed. */
+static inline uint64_t
+mixKey(
+    uint64_t fingerprint,
+    char const *key
+) {
+    if (key) {
+        for (; *key; ++key)
+            fingerprint = (fingerprint ^ (unsigned char) *key) * 0x100000001B3u;
+    }
+
+    /* Terminator separates keys, absent and empty keys are both left out of index. */
+    return (fingerprint ^ 0x100u) * 0x100000001B3u;
+}
+
+/*
+ * Digests every property of options which index depends on.
+ *
+ * Options are digested independently, seeded by their index, and summed,
+ * so digests of consecutive options overlap instead of forming one long chain.
+ */
+static inline uint64_t
+getFingerprint(
+    cla_schema_t const *schema
+) {
+    uint64_t
+        fingerprint = mixFingerprint(0x9E3779B97F4A7C15u, schema->numberOfOptions);
+
+    for (size_t i = 0; i < schema->numberOfOptions; ++i) {
+        cla_option_t const
+            *option = &schema->options[i];
+        uint64_t
+            digest = 0xCBF29CE484222325u ^ i;
+
+        digest = mixKey(digest, option->name);
+        digest = mixKey(digest, option->synonym);
+        digest = mixKey(digest, option->environmentName);
+        digest = (digest ^ ((unsigned) (unsigned char) option->tag << 1 | option->isRequired)) * 0x100000001B3u;
+
+        fingerprint += mixFingerprint(digest, i);
+    }
+
+    return fingerprint;
+}
+
+static inline bool
+isAlignedImage(
+    void const *image
+) {
+    return (uintptr_t) image % sizeof(uint64_t) == 0;
+}
+
+size_t
+cla_getSchemaImageSize(
+    cla_schema_t const *schema
+) {
+    return schema
+        ? sizeof(header_t) + schema->numberOfSlots * sizeof(cla_slot_t)
+        : 0;
+}
+
+int
+cla_saveSchema(
+    cla_schema_t const *schema,
+    void *image,
+    size_t size
+) {
+    header_t
+        *header = image;
+
+    if (!schema || !schema->options || !schema->slots || !image)
+        /* Null @schema, its storage, or @image. */
+        return cla_nullReferenceError;
+
+    if (!isAlignedImage(image))
+        /* Header fields could not be read in place. */
+        return cla_illegalInputError;
+
+    if (size < cla_getSchemaImageSize(schema))
+        /* Image does not fit. */
+        return cla_outOfMemoryError;
+
+    *header = (header_t) {
+        .magic = imageMagic,
+        .version = cla_schemaImageVersion,
+        .fingerprint = getFingerprint(schema),
+        .numberOfOptions = schema->numberOfOptions,
+        .numberOfSlots = schema->numberOfSlots,
+        .numberOfRequiredOptions = schema->numberOfRequiredOptions,
+        .numberOfEnvironmentOptions = schema->numberOfEnvironmentOptions,
+    };
+
+    memcpy(header->tags, schema->tags, sizeof header->tags);
+    memcpy(header + 1, schema->slots, schema->numberOfSlots * sizeof *schema->slots);
+
+    return cla_noErrors;
+}
+
+int
+cla_loadSchema(
+    cla_schema_t *schema,
+    void const *image,
+    size_t size
+) {
+    header_t const
+        *header = image;
+
+    if (!schema || !schema->options || !image)
+        /* Null @schema, its options, or @image. */
+        return cla_nullReferenceError;
+
+    if (!isAlignedImage(image) || size < sizeof *header)
+        /* Header could not be read in place. */
+        return cla_illegalInputError;
+
+    if (header->magic != imageMagic || header->version != cla_schemaImageVersion ||
+        header->numberOfOptions != schema->numberOfOptions ||
+        header->numberOfSlots < cla_numberOfSlots(header->numberOfOptions) ||
+        (size - sizeof *header) / sizeof(cla_slot_t) != header->numberOfSlots)
+        /* Image has another byte order, layout, or shape. */
+        return cla_illegalInputError;
+
+    if (header->fingerprint != getFingerprint(schema))
+        /* Image was built from different options. */
+        return cla_illegalInputError;
+
+    /* Parser only reads slots, so image may stay read-only. */
+    schema->slots = (cla_slot_t *) (header + 1);
+    schema->numberOfSlots = (size_t) header->numberOfSlots;
+    schema->numberOfRequiredOptions = (size_t) header->numberOfRequiredOptions;
+    schema->numberOfEnvironmentOptions = (size_t) header->numberOfEnvironmentOptions;
+    memcpy(schema->tags, header->tags, sizeof schema->tags);
+
+    return cla_noErrors;
+}
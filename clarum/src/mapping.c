@@ -0,0 +1,149 @@
+#include "mapping.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <unistd.h>
+#endif
+
+#if defined(_POSIX_MAPPED_FILES) && _POSIX_MAPPED_FILES > 0
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+#if defined(MAP_ANONYMOUS) && defined(MAP_FIXED)
+
+#if !defined(O_CLOEXEC)
+#define O_CLOEXEC 0
+#endif
+
+int
+cla_mapFile(
+    cla_mapping_t *mapping,
+    char const *path
+) {
+    struct stat
+        status;
+    size_t
+        size;
+    void
+        *address;
+    int
+        descriptor = open(path, O_RDONLY | O_CLOEXEC);
+
+    if (descriptor < 0)
+        return cla_fileError;
+
+    if (fstat(descriptor, &status)) {
+        close(descriptor);
+        return cla_fileError;
+    }
+
+    size = (size_t) status.st_size;
+
+    /* Reserves anonymous zero-filled region with room for terminator,
+     * then places file over its head. */
+    address = mmap(NULL, size + 1, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (address == MAP_FAILED) {
+        close(descriptor);
+        return cla_outOfMemoryError;
+    }
+
+    if (size && mmap(address, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_FIXED, descriptor, 0) == MAP_FAILED) {
+        munmap(address, size + 1);
+        close(descriptor);
+        return cla_fileError;
+    }
+
+    close(descriptor);
+
+    mapping->address = address;
+    mapping->size = size;
+
+    return cla_noErrors;
+}
+
+void
+cla_unmapFile(
+    cla_mapping_t *mapping
+) {
+    if (mapping->address)
+        munmap(mapping->address, mapping->size + 1);
+
+    mapping->address = NULL;
+    mapping->size = 0;
+}
+
+#else
+
+#include <stdio.h>
+#include <stdlib.h>
+
+/* Initial capacity of buffer holding file read without mmap. */
+#define minimumCapacity 4096
+
+int
+cla_mapFile(
+    cla_mapping_t *mapping,
+    char const *path
+) {
+    char
+        *address = NULL;
+    size_t
+        size = 0,
+        capacity = 0;
+    bool
+        hasFailed;
+    FILE
+        *file = fopen(path, "rb");
+
+    if (!file)
+        return cla_fileError;
+
+    /* Reads whole file, keeping room for terminator. */
+    do {
+        if (capacity - size < 2) {
+            size_t const
+                newCapacity = capacity ? 2 * capacity : minimumCapacity;
+            char
+                *newAddress = newCapacity > capacity ? realloc(address, newCapacity) : NULL;
+
+            if (!newAddress) {
+                free(address);
+                fclose(file);
+                return cla_outOfMemoryError;
+            }
+
+            address = newAddress;
+            capacity = newCapacity;
+        }
+
+        size += fread(&address[size], 1, capacity - size - 1, file);
+    } while (!feof(file) && !ferror(file));
+
+    hasFailed = ferror(file);
+    fclose(file);
+
+    if (hasFailed) {
+        free(address);
+        return cla_fileError;
+    }
+
+    address[size] = '\0';
+
+    mapping->address = address;
+    mapping->size = size;
+
+    return cla_noErrors;
+}
+
+void
+cla_unmapFile(
+    cla_mapping_t *mapping
+) {
+    free(mapping->address);
+
+    mapping->address = NULL;
+    mapping->size = 0;
+}
+
+#endif
@@ -0,0 +1,19 @@
+#pragma once
+
+#include <clarum/clarum.h>
+
+/*
+ * Maps file at @path privately with write access, so that it may be split in place;
+ * one zero byte past the end is always mapped, so the last token can be terminated.
+ * Without mmap, e.g. outside POSIX, file is read into heap buffer instead.
+ */
+int
+cla_mapFile(
+    cla_mapping_t *mapping,
+    char const *path
+);
+
+void
+cla_unmapFile(
+    cla_mapping_t *mapping
+);
@@ -0,0 +1,108 @@
+#include "schema.h"
+
+static inline int
+insertKey(
+    cla_schema_t *schema,
+    size_t index,
+    unsigned kind
+) {
+    char const
+        *key = getKey(&schema->options[index], kind);
+    size_t
+        length;
+    uint32_t
+        hash;
+
+    if (!key || !key[0])
+        /* Option has no such form. */
+        return cla_noErrors;
+
+    length = strlen(key);
+    hash = hashKey(key, length);
+
+    if (findKey(schema, NULL, key, length, kind == environmentKey))
+        /* @key is already taken by another name, synonym, or environment name. */
+        return cla_illegalInputError;
+
+    for (size_t i = getHomeSlot(hash, schema->numberOfSlots);; ) {
+        cla_slot_t
+            *slot = &schema->slots[i];
+
+        if (!slot->entry) {
+            slot->hash = hash;
+            slot->entry = encodeEntry(index, kind);
+            return cla_noErrors;
+        }
+
+        if (++i == schema->numberOfSlots)
+            i = 0;
+    }
+}
+
+static inline int
+insertTag(
+    cla_schema_t *schema,
+    size_t index
+) {
+    unsigned char const
+        tag = (unsigned char) schema->options[index].tag;
+
+    if (!tag)
+        /* Option has no short form. */
+        return cla_noErrors;
+
+    if (schema->tags[tag])
+        /* @tag is already taken by another option. */
+        return cla_illegalInputError;
+
+    schema->tags[tag] = (uint32_t) index + 1;
+    return cla_noErrors;
+}
+
+int
+cla_compileSchema(
+    cla_schema_t *schema
+) {
+    if (!schema || !schema->options || !schema->slots)
+        /* Null @schema, or its storage. */
+        return cla_nullReferenceError;
+
+    if (schema->numberOfSlots < cla_numberOfSlots(schema->numberOfOptions) ||
+        schema->numberOfOptions >= UINT32_MAX / numberOfKeyKinds)
+        /* Index would be overloaded, or entries would not fit. */
+        return cla_illegalInputError;
+
+    memset(schema->slots, 0, schema->numberOfSlots * sizeof *schema->slots);
+    memset(schema->tags, 0, sizeof schema->tags);
+    schema->numberOfRequiredOptions = 0;
+    schema->numberOfEnvironmentOptions = 0;
+
+    for (size_t i = 0; i < schema->numberOfOptions; ++i) {
+        int
+            status;
+
+        status = insertKey(schema, i, nameKey);
+        if (status)
+            return status;
+
+        status = insertKey(schema, i, synonymKey);
+        if (status)
+            return status;
+
+        status = insertKey(schema, i, environmentKey);
+        if (status)
+            return status;
+
+        status = insertTag(schema, i);
+        if (status)
+            return status;
+
+        if (schema->options[i].isRequired)
+            ++schema->numberOfRequiredOptions;
+
+        if (schema->options[i].environmentName && schema->options[i].environmentName[0])
+            ++schema->numberOfEnvironmentOptions;
+    }
+
+    return cla_noErrors;
+}
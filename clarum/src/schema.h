@@ -0,0 +1,182 @@
+#pragma once
+
+#include "statistics.h"
+#include <clarum/clarum.h>
+#include <string.h>
+
+enum {
+    nameKey = 0,
+    synonymKey,
+    environmentKey,
+    numberOfKeyKinds = 4,
+};
+
+static inline uint32_t
+encodeEntry(
+    size_t index,
+    unsigned kind
+) {
+    /* Zero is reserved for vacant slots. */
+    return (uint32_t) (index + 1) * numberOfKeyKinds + kind;
+}
+
+static inline size_t
+decodeIndex(
+    uint32_t entry
+) {
+    return entry / numberOfKeyKinds - 1;
+}
+
+static inline unsigned
+decodeKind(
+    uint32_t entry
+) {
+    return entry % numberOfKeyKinds;
+}
+
+/* Mixes @length bytes of @key into @hash. */
+static inline uint64_t
+mixBytes(
+    uint64_t hash,
+    char const *key,
+    size_t length
+) {
+    uint64_t
+        word;
+
+    /* Consumes key word by word, tail is zero-padded. */
+    for (; length >= sizeof word; key += sizeof word, length -= sizeof word) {
+        memcpy(&word, key, sizeof word);
+        hash = (hash ^ word) * 0xBF58476D1CE4E5B9u;
+        hash ^= hash >> 31;
+    }
+
+    if (length) {
+        word = 0;
+        memcpy(&word, key, length);
+        hash = (hash ^ word) * 0xBF58476D1CE4E5B9u;
+        hash ^= hash >> 31;
+    }
+
+    return hash;
+}
+
+static inline uint32_t
+hashKey(
+    char const *key,
+    size_t length
+) {
+    return (uint32_t) (mixBytes(0x9E3779B97F4A7C15u ^ length, key, length) >> 32);
+}
+
+static inline size_t
+getHomeSlot(
+    uint32_t hash,
+    size_t numberOfSlots
+) {
+    /* Maps hash onto [0, numberOfSlots) without division. */
+    return (size_t) (((uint64_t) hash * numberOfSlots) >> 32);
+}
+
+static inline char const *
+getKey(
+    cla_option_t const *option,
+    unsigned kind
+) {
+    switch (kind) {
+    case synonymKey:
+        return option->synonym;
+
+    case environmentKey:
+        return option->environmentName;
+
+    default:
+        return option->name;
+    }
+}
+
+static inline bool
+keyEquals(
+    char const *key,
+    char const *str,
+    size_t length
+) {
+    /* Measures @key first, so shorter keys are never over-read,
+     * even when @str is length-delimited and holds terminators. */
+    return key
+        ? strnlen(key, length + 1) == length && !memcmp(key, str, length)
+        : false;
+}
+
+/* Resolves @length leading characters of @str via schema index, counting comparisons into @result, if any. */
+static inline cla_option_t *
+findKey(
+    cla_schema_t const *schema,
+    cla_result_t *result,
+    char const *str,
+    size_t length,
+    bool isVariable
+) {
+    uint32_t const
+        hash = hashKey(str, length);
+
+    (void) result;
+
+    for (size_t i = getHomeSlot(hash, schema->numberOfSlots);; ) {
+        cla_slot_t const
+            slot = schema->slots[i];
+
+        if (!slot.entry)
+            /* Vacant slot terminates probe sequence. */
+            return NULL;
+
+        /* Environment names share index with option names, but never match them. */
+        if (slot.hash == hash && (decodeKind(slot.entry) == environmentKey) == isVariable) {
+            cla_option_t
+                *option = &schema->options[decodeIndex(slot.entry)];
+
+            addStatistic(result, numberOfComparisons, 1);
+            if (keyEquals(getKey(option, decodeKind(slot.entry)), str, length))
+                return option;
+        }
+
+        if (++i == schema->numberOfSlots)
+            i = 0;
+    }
+}
+
+/* Resolves option name, or synonym. */
+static inline cla_option_t *
+findOption(
+    cla_schema_t const *schema,
+    cla_result_t *result,
+    char const *str,
+    size_t length
+) {
+    return findKey(schema, result, str, length, false);
+}
+
+/* Resolves environment variable name. */
+static inline cla_option_t *
+findVariable(
+    cla_schema_t const *schema,
+    cla_result_t *result,
+    char const *str,
+    size_t length
+) {
+    return findKey(schema, result, str, length, true);
+}
+
+/* Resolves tag character @chr via schema tag table. */
+static inline cla_option_t *
+findTaggedOption(
+    cla_schema_t const *schema,
+    char chr
+) {
+    uint32_t const
+        entry = schema->tags[(unsigned char) chr];
+
+    return entry
+        ? &schema->options[entry - 1]
+        : NULL;
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <clarum/clarum.h>
+
+#if defined(CLARUM_STATISTICS)
+#include <string.h>
+#include <time.h>
+
+static inline uint64_t
+getTimestamp(
+    void
+) {
+    struct timespec
+        time;
+
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return (uint64_t) time.tv_sec * 1000000000u + (uint64_t) time.tv_nsec;
+}
+
+/* Adds @value to statistics field of @result, if any. */
+#define addStatistic(result, field, value) \
+    ((result) ? (void) ((result)->statistics.field += (value)) : (void) 0)
+
+#else
+
+/* Statistics are compiled out, arguments are not evaluated. */
+#define addStatistic(result, field, value) \
+    ((void) 0)
+
+#endif
+
+static inline void
+resetStatistics(
+    cla_result_t *result
+) {
+#if defined(CLARUM_STATISTICS)
+    memset(&result->statistics, 0, sizeof result->statistics);
+#else
+    (void) result;
+#endif
+}
+
+/* Returns start timestamp of parse call, if statistics are collected. */
+static inline uint64_t
+beginTiming(
+    void
+) {
+#if defined(CLARUM_STATISTICS)
+    return getTimestamp();
+#else
+    return 0;
+#endif
+}
+
+/* Accounts parse call started at @start into @result. */
+static inline void
+endTiming(
+    cla_result_t *result,
+    uint64_t start
+) {
+#if defined(CLARUM_STATISTICS)
+    result->statistics.parseTime += getTimestamp() - start;
+#else
+    (void) result, (void) start;
+#endif
+}
@@ -0,0 +1,211 @@
+#include "suggestion.h"
+#include <string.h>
+
+enum {
+    /* Pattern is held in single machine word. */
+    maximumPatternLength = 64,
+    maximumDistance = 3,
+};
+
+/* Represents pattern prepared for bit-parallel search. */
+typedef
+    struct pattern_t
+    pattern_t;
+
+struct pattern_t {
+    /* Bit i of entry c is set iff character i of pattern is c. */
+    uint64_t matches[256];
+    uint64_t signature;
+    size_t length;
+    unsigned bound;
+};
+
+/* Maps character onto one of 64 signature bits, folding rare characters onto common ones. */
+static inline uint64_t
+getSignatureBit(
+    char chr
+) {
+    return (uint64_t) 1 << ((unsigned char) chr & 63);
+}
+
+/* Tells whether at most @bound bits are set, without population count instruction, which is not baseline. */
+static inline bool
+hasAtMostBits(
+    uint64_t bits,
+    unsigned bound
+) {
+    for (unsigned i = 0; i < bound && bits; ++i)
+        bits &= bits - 1;
+
+    return !bits;
+}
+
+/*
+ * Computes edit distance between pattern and @length characters of @text
+ * by Myers' bit-parallel algorithm, in Hyyro's formulation for global distance;
+ * returns bound plus one as soon as distance is known to exceed bound.
+ */
+static inline unsigned
+getDistance(
+    pattern_t const *pattern,
+    char const *text,
+    size_t length
+) {
+    uint64_t const
+        highBit = (uint64_t) 1 << (pattern->length - 1);
+    uint64_t
+        positives = ~(uint64_t) 0,
+        negatives = 0;
+    size_t
+        score = pattern->length;
+
+    for (size_t j = 0; j < length; ++j) {
+        uint64_t const
+            matches = pattern->matches[(unsigned char) text[j]],
+            vertical = matches | negatives,
+            horizontal = (((matches & positives) + positives) ^ positives) | matches;
+        uint64_t
+            horizontalPositives = negatives | ~(horizontal | positives),
+            horizontalNegatives = positives & horizontal;
+
+        if (horizontalPositives & highBit)
+            ++score;
+        else if (horizontalNegatives & highBit)
+            --score;
+
+        /* Score falls by at most one per remaining character. */
+        if (score > pattern->bound + (length - j - 1))
+            return pattern->bound + 1;
+
+        /* Top row of global distance grows by one per text character. */
+        horizontalPositives = horizontalPositives << 1 | 1;
+        horizontalNegatives <<= 1;
+        positives = horizontalNegatives | ~(vertical | horizontalPositives);
+        negatives = horizontalPositives & vertical;
+    }
+
+    return (unsigned) score;
+}
+
+/* Measures @key, pruning by length and character signature before computing distance. */
+static inline unsigned
+getKeyDistance(
+    pattern_t const *pattern,
+    char const *key
+) {
+    size_t const
+        maximumLength = pattern->length + pattern->bound;
+    uint64_t
+        signature = 0;
+    size_t
+        length = 0;
+
+    if (!key)
+        return pattern->bound + 1;
+
+    for (; key[length]; ++length) {
+        if (length == maximumLength)
+            /* Key is too long. */
+            return pattern->bound + 1;
+
+        signature |= getSignatureBit(key[length]);
+    }
+
+    if (length + pattern->bound < pattern->length)
+        /* Key is too short. */
+        return pattern->bound + 1;
+
+    /* Every character missing from one side takes separate edit. */
+    if (!hasAtMostBits(pattern->signature & ~signature, pattern->bound) ||
+        !hasAtMostBits(signature & ~pattern->signature, pattern->bound))
+        return pattern->bound + 1;
+
+    return getDistance(pattern, key, length);
+}
+
+/* Inserts @option into suggestions ordered by distance, keeping earlier options on ties. */
+static inline void
+addSuggestion(
+    cla_diagnostic_t *diagnostic,
+    unsigned *distances,
+    cla_option_t const *option,
+    unsigned distance
+) {
+    size_t
+        i = diagnostic->numberOfSuggestions;
+
+    if (i == cla_maximumNumberOfSuggestions) {
+        if (distances[i - 1] <= distance)
+            return;
+
+        --i;
+    } else {
+        ++diagnostic->numberOfSuggestions;
+    }
+
+    for (; i && distances[i - 1] > distance; --i) {
+        diagnostic->suggestions[i] = diagnostic->suggestions[i - 1];
+        distances[i] = distances[i - 1];
+    }
+
+    diagnostic->suggestions[i] = option;
+    distances[i] = distance;
+}
+
+void
+cla_suggestOptions(
+    cla_schema_t const *schema,
+    cla_diagnostic_t *diagnostic,
+    char const *str,
+    size_t length
+) {
+    pattern_t
+        pattern;
+    unsigned
+        distances[cla_maximumNumberOfSuggestions];
+
+    diagnostic->numberOfSuggestions = 0;
+
+    if (!length || length > maximumPatternLength)
+        /* Pattern does not fit in machine word. */
+        return;
+
+    memset(pattern.matches, 0, sizeof pattern.matches);
+    pattern.signature = 0;
+    pattern.length = length;
+    /* Allows one edit per four characters, so that short names are not matched by anything. */
+    pattern.bound = length / 4 + 1 < maximumDistance
+        ? (unsigned) (length / 4 + 1)
+        : maximumDistance;
+
+    for (size_t i = 0; i < length; ++i) {
+        pattern.matches[(unsigned char) str[i]] |= (uint64_t) 1 << i;
+        pattern.signature |= getSignatureBit(str[i]);
+    }
+
+    for (size_t i = 0; i < schema->numberOfOptions; ++i) {
+        cla_option_t const
+            *option = &schema->options[i];
+        unsigned const
+            nameDistance = getKeyDistance(&pattern, option->name),
+            synonymDistance = getKeyDistance(&pattern, option->synonym),
+            distance = nameDistance < synonymDistance ? nameDistance : synonymDistance;
+
+        if (distance > pattern.bound)
+            continue;
+
+        addSuggestion(diagnostic, distances, option, distance);
+
+        if (diagnostic->numberOfSuggestions == cla_maximumNumberOfSuggestions) {
+            unsigned const
+                farthest = distances[cla_maximumNumberOfSuggestions - 1];
+
+            if (!farthest)
+                /* Nothing can be closer. */
+                return;
+
+            /* Later options take place only when strictly closer, which prunes most of them early. */
+            pattern.bound = farthest - 1;
+        }
+    }
+}
@@ -0,0 +1,15 @@
+#pragma once
+
+#include <clarum/clarum.h>
+
+/*
+ * Fills suggestions of @diagnostic with options whose name or synonym
+ * lies within small edit distance of @length characters of @str.
+ */
+void
+cla_suggestOptions(
+    cla_schema_t const *schema,
+    cla_diagnostic_t *diagnostic,
+    char const *str,
+    size_t length
+);
@@ -0,0 +1,342 @@
+#pragma once
+
+#include "bits.h"
+#include <clarum/clarum.h>
+#include <string.h>
+
+#if defined(__AVX2__) && !defined(__SANITIZE_ADDRESS__)
+#include <immintrin.h>
+#define CLARUM_SCAN_WIDTH 32
+#elif defined(__SSE2__) && !defined(__SANITIZE_ADDRESS__)
+#include <emmintrin.h>
+#define CLARUM_SCAN_WIDTH 16
+#elif !defined(__SANITIZE_ADDRESS__)
+#define CLARUM_SCAN_WIDTH 8
+#endif
+
+/* Public token is used as is, so that cla_tokenize() costs nothing extra. */
+typedef
+    cla_token_t
+    token_t;
+
+#if CLARUM_SCAN_WIDTH == 8
+static inline uint64_t
+getSwarMatches(
+    uint64_t word
+) {
+    uint64_t const
+        ones = 0x0101010101010101u,
+        highs = 0x8080808080808080u,
+        delimiters = word ^ (ones * '=');
+
+    /* Flags zero and '=' bytes, lowest flag is always exact. */
+    return ((word - ones) & ~word & highs) | ((delimiters - ones) & ~delimiters & highs);
+}
+#endif
+
+/*
+ * Finds first '=' or terminator in @str.
+ *
+ * Vector paths only issue aligned loads, which never cross page boundary,
+ * so reading past terminator within the same block is safe.
+ */
+static inline size_t
+findDelimiter(
+    char const *str
+) {
+#if defined(CLARUM_SCAN_WIDTH)
+    size_t const
+        offset = (size_t) ((uintptr_t) str % CLARUM_SCAN_WIDTH);
+#endif
+#if CLARUM_SCAN_WIDTH > 8
+    char const
+        *block = str - offset;
+#endif
+
+#if CLARUM_SCAN_WIDTH == 32
+    __m256i const
+        zeros = _mm256_setzero_si256(),
+        delimiters = _mm256_set1_epi8('=');
+    uint32_t
+        mask;
+
+    for (mask = ~(uint32_t) 0 << offset;; block += CLARUM_SCAN_WIDTH, mask = ~(uint32_t) 0) {
+        __m256i const
+            chunk = _mm256_load_si256((__m256i const *) block);
+
+        mask &= (uint32_t) _mm256_movemask_epi8(_mm256_or_si256(
+            _mm256_cmpeq_epi8(chunk, zeros),
+            _mm256_cmpeq_epi8(chunk, delimiters)));
+
+        if (mask)
+            return (size_t) (block - str) + (size_t) countTrailingZeros(mask);
+    }
+#elif CLARUM_SCAN_WIDTH == 16
+    __m128i const
+        zeros = _mm_setzero_si128(),
+        delimiters = _mm_set1_epi8('=');
+    uint32_t
+        mask;
+
+    for (mask = ~(uint32_t) 0 << offset;; block += CLARUM_SCAN_WIDTH, mask = ~(uint32_t) 0) {
+        __m128i const
+            chunk = _mm_load_si128((__m128i const *) block);
+
+        mask &= (uint32_t) _mm_movemask_epi8(_mm_or_si128(
+            _mm_cmpeq_epi8(chunk, zeros),
+            _mm_cmpeq_epi8(chunk, delimiters)));
+
+        if (mask)
+            return (size_t) (block - str) + (size_t) countTrailingZeros(mask);
+    }
+#elif CLARUM_SCAN_WIDTH == 8
+    size_t
+        length = 0;
+
+    /* Scans unaligned head byte by byte. */
+    for (; offset && length < CLARUM_SCAN_WIDTH - offset; ++length) {
+        if (!str[length] || str[length] == '=')
+            return length;
+    }
+
+    for (;; length += CLARUM_SCAN_WIDTH) {
+        uint64_t
+            word;
+
+        memcpy(&word, &str[length], sizeof word);
+        if (getSwarMatches(word))
+            break;
+    }
+
+    /* Locates match within the word regardless of byte order. */
+    while (str[length] && str[length] != '=')
+        ++length;
+
+    return length;
+#else
+    size_t
+        length = 0;
+
+    while (str[length] && str[length] != '=')
+        ++length;
+
+    return length;
+#endif
+}
+
+/* Splits terminated @str into name and value in a single pass. */
+static inline void
+tokenize(
+    token_t *token,
+    char *str
+) {
+    size_t const
+        length = findDelimiter(str);
+
+    token->name = str;
+    token->nameLength = length;
+
+    if (str[length]) {
+        /* Skips the delimiter. */
+        token->value = &str[length + 1];
+        token->valueLength = strlen(token->value);
+    } else {
+        token->value = NULL;
+        token->valueLength = 0;
+    }
+}
+
+/* Splits @length characters of @str, which need not be terminated. */
+static inline void
+tokenizeBounded(
+    token_t *token,
+    char *str,
+    size_t length
+) {
+    char
+        *delimiter = memchr(str, '=', length);
+
+    token->name = str;
+
+    if (delimiter) {
+        token->nameLength = (size_t) (delimiter - str);
+        token->value = delimiter + 1;
+        token->valueLength = length - token->nameLength - 1;
+    } else {
+        token->nameLength = length;
+        token->value = NULL;
+        token->valueLength = 0;
+    }
+}
+
+static inline bool
+isWordSeparator(
+    char chr
+) {
+    return chr == ' ' || chr == '\t' || chr == '\n' || chr == '\r' ||
+        chr == '\v' || chr == '\f' || chr == '\0';
+}
+
+/*
+ * Extracts next word from [@cursor, @end) in place, honouring single quotes,
+ * double quotes and backslash escapes; returns NULL when input is exhausted.
+ *
+ * Unescaped word is written over its source and terminated,
+ * hence byte at @end shall be writable.
+ */
+static inline char *
+splitWord(
+    char **cursor,
+    char *end
+) {
+    char
+        *read = *cursor,
+        *write,
+        *word,
+        quote = 0;
+
+    while (read < end && isWordSeparator(*read))
+        ++read;
+
+    if (read == end) {
+        *cursor = end;
+        return NULL;
+    }
+
+    for (word = write = read; read < end; ) {
+        char const
+            chr = *read;
+
+        if (quote) {
+            if (chr == quote) {
+                quote = 0;
+                ++read;
+            } else if (chr == '\\' && quote == '"' && read + 1 < end) {
+                *write++ = read[1];
+                read += 2;
+            } else {
+                *write++ = *read++;
+            }
+        } else if (isWordSeparator(chr)) {
+            break;
+        } else if (chr == '\'' || chr == '"') {
+            quote = chr;
+            ++read;
+        } else if (chr == '\\' && read + 1 < end) {
+            *write++ = read[1];
+            read += 2;
+        } else {
+            *write++ = *read++;
+        }
+    }
+
+    /* Skips separator, which may be overwritten by terminator. */
+    *cursor = read < end
+        ? read + 1
+        : end;
+    *write = '\0';
+
+    return word;
+}
+
+static inline bool
+isBlankCharacter(
+    char chr
+) {
+    return chr == ' ' || chr == '\t' || chr == '\r' || chr == '\v' || chr == '\f';
+}
+
+/*
+ * Extracts next 'key = value' setting from [@cursor, @end) in place,
+ * skipping blank lines, '#' and ';' comments, and '[section]' headers;
+ * token name is NULL when input is exhausted, and spans offending line on error.
+ *
+ * Key is left unterminated, while value is unquoted and terminated,
+ * hence byte at @end shall be writable.
+ */
+static inline int
+splitSetting(
+    char **cursor,
+    char *end,
+    token_t *token
+) {
+    while (*cursor < end) {
+        char
+            *line = *cursor,
+            *lineEnd = memchr(line, '\n', (size_t) (end - line)),
+            *delimiter;
+
+        if (!lineEnd)
+            lineEnd = end;
+
+        *cursor = lineEnd < end
+            ? lineEnd + 1
+            : end;
+
+        while (line < lineEnd && isBlankCharacter(*line))
+            ++line;
+
+        while (lineEnd > line && isBlankCharacter(lineEnd[-1]))
+            --lineEnd;
+
+        if (line == lineEnd || *line == '#' || *line == ';')
+            /* Blank line, or comment. */
+            continue;
+
+        if (*line == '[') {
+            if (lineEnd[-1] != ']') {
+                /* Unterminated section header. */
+                token->name = line;
+                token->nameLength = (size_t) (lineEnd - line);
+                return cla_illegalInputError;
+            }
+
+            /* Sections only group keys. */
+            continue;
+        }
+
+        delimiter = memchr(line, '=', (size_t) (lineEnd - line));
+
+        token->name = line;
+        token->nameLength = (size_t) ((delimiter ? delimiter : lineEnd) - line);
+
+        while (token->nameLength && isBlankCharacter(line[token->nameLength - 1]))
+            --token->nameLength;
+
+        if (!token->nameLength) {
+            /* Setting has no key. */
+            token->nameLength = (size_t) (lineEnd - line);
+            return cla_illegalInputError;
+        }
+
+        if (delimiter) {
+            char
+                *value = delimiter + 1;
+
+            while (value < lineEnd && isBlankCharacter(*value))
+                ++value;
+
+            if (lineEnd - value >= 2 && (*value == '"' || *value == '\'') && lineEnd[-1] == *value) {
+                /* Quotes only preserve surrounding blanks. */
+                ++value;
+                --lineEnd;
+            }
+
+            /* Overwrites closing quote, blank, newline, or byte at @end. */
+            *lineEnd = '\0';
+
+            token->value = value;
+            token->valueLength = (size_t) (lineEnd - value);
+        } else {
+            token->value = NULL;
+            token->valueLength = 0;
+        }
+
+        return cla_noErrors;
+    }
+
+    token->name = NULL;
+    token->nameLength = 0;
+
+    return cla_noErrors;
+}
@@ -0,0 +1,630 @@
+#include <clarum/clarum.h>
+#include <ctype.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*
+ * Emits C parser specialized for single schema.
+ *
+ * Schema is X-macro file compiled into this generator via CLARUM_SCHEMA,
+ * so options are evaluated by C compiler itself; each line reads
+ *
+ *     cla_defineOption(identifier, name, synonym, tag, handler, isRequired, isTerminal)
+ *
+ * Generated parser resolves names by switch over length and characters,
+ * calls handlers directly, and tracks required options in a bitset,
+ * while behaving exactly as cla_parseOptions() over the same options.
+ *
+ * Generated source also holds image of compiled schema index
+ * (see cla_saveSchema()), so programs parsing via cla_parse()
+ * may load index instead of compiling it on startup.
+ */
+
+#if !defined(CLARUM_SCHEMA)
+#error CLARUM_SCHEMA shall name schema file
+#endif
+
+typedef struct {
+    char const *identifier;
+    char const *name;
+    char const *synonym;
+    char tag;
+    char const *handler;
+    bool isRequired;
+    bool isTerminal;
+} definition_t;
+
+/* Represents name or synonym resolving to option. */
+typedef struct {
+    char const *key;
+    size_t length;
+    size_t index;
+} entry_t;
+
+static definition_t const
+    definitions[] = {
+#define cla_defineOption(identifier, name, synonym, tag, handler, isRequired, isTerminal) \
+    {#identifier, name, synonym, tag, #handler, isRequired, isTerminal},
+#include CLARUM_SCHEMA
+#undef cla_defineOption
+        /* Sentinel keeps array valid for empty schemas. */
+        {NULL, NULL, NULL, '\0', NULL, false, false},
+    };
+
+static size_t const
+    numberOfDefinitions = sizeof definitions / sizeof *definitions - 1;
+
+/* Keys of options matching generated initializer, from which index image is compiled. */
+static cla_option_t
+    options[] = {
+#define cla_defineOption(identifier, optionName, optionSynonym, optionTag, handler, optionIsRequired, isTerminal) \
+    {.tag = optionTag, .name = optionName, .synonym = optionSynonym, .isRequired = optionIsRequired},
+#include CLARUM_SCHEMA
+#undef cla_defineOption
+        {.name = NULL},
+    };
+
+/* Strips address-of operator, returns NULL for options without handler. */
+static char const *
+getHandler(
+    definition_t const *definition
+) {
+    char const
+        *handler = definition->handler;
+
+    while (*handler == '&' || isspace((unsigned char) *handler))
+        ++handler;
+
+    return strcmp(handler, "NULL") && strcmp(handler, "0")
+        ? handler
+        : NULL;
+}
+
+static int
+compareKeys(
+    void const *lhs,
+    void const *rhs
+) {
+    entry_t const
+        *left = lhs,
+        *right = rhs;
+    int
+        order;
+
+    if (left->length != right->length)
+        return left->length < right->length ? -1 : 1;
+
+    order = memcmp(left->key, right->key, left->length);
+    if (order)
+        return order;
+
+    /* Equal keys resolve to first option, as in cla_parseOptions(). */
+    return left->index < right->index ? -1 : left->index > right->index;
+}
+
+static void
+addKey(
+    entry_t *keys,
+    size_t *numberOfKeys,
+    char const *key,
+    size_t index
+) {
+    if (key && *key) {
+        keys[*numberOfKeys] = (entry_t) {
+            .key = key,
+            .length = strlen(key),
+            .index = index,
+        };
+        ++*numberOfKeys;
+    }
+}
+
+/* Sorts keys and drops those shadowed by earlier options. */
+static size_t
+makeKeys(
+    entry_t *keys
+) {
+    size_t
+        numberOfKeys = 0,
+        numberOfUniqueKeys = 0;
+
+    for (size_t i = 0; i < numberOfDefinitions; ++i) {
+        addKey(keys, &numberOfKeys, definitions[i].name, i);
+        addKey(keys, &numberOfKeys, definitions[i].synonym, i);
+    }
+
+    qsort(keys, numberOfKeys, sizeof *keys, &compareKeys);
+
+    for (size_t i = 0; i < numberOfKeys; ++i) {
+        if (numberOfUniqueKeys && keys[numberOfUniqueKeys - 1].length == keys[i].length &&
+            !memcmp(keys[numberOfUniqueKeys - 1].key, keys[i].key, keys[i].length))
+            continue;
+
+        keys[numberOfUniqueKeys++] = keys[i];
+    }
+
+    return numberOfUniqueKeys;
+}
+
+static bool
+isPlainCharacter(
+    char chr
+) {
+    return isalnum((unsigned char) chr) || chr == '-' || chr == '_' || chr == '.' || chr == '+';
+}
+
+static void
+writeCharacter(
+    FILE *file,
+    char chr
+) {
+    if (isPlainCharacter(chr))
+        fprintf(file, "'%c'", chr);
+    else
+        fprintf(file, "'\\x%02x'", (unsigned char) chr);
+}
+
+static void
+writeString(
+    FILE *file,
+    char const *str,
+    size_t length
+) {
+    fputc('"', file);
+
+    for (size_t i = 0; i < length; ++i) {
+        if (isPlainCharacter(str[i]))
+            fputc(str[i], file);
+        else
+            /* Octal escapes never absorb following characters beyond three digits. */
+            fprintf(file, "\\%03o", (unsigned char) str[i]);
+    }
+
+    fputc('"', file);
+}
+
+static void
+writeOptionalString(
+    FILE *file,
+    char const *str
+) {
+    if (str)
+        writeString(file, str, strlen(str));
+    else
+        fputs("NULL", file);
+}
+
+static void
+indent(
+    FILE *file,
+    size_t depth
+) {
+    for (size_t i = 0; i < depth; ++i)
+        fputs("    ", file);
+}
+
+/* Emits decision tree over keys of equal length sharing first @offset characters. */
+static void
+writeNameSwitch(
+    FILE *file,
+    entry_t const *keys,
+    size_t numberOfKeys,
+    size_t offset,
+    size_t depth
+) {
+    if (numberOfKeys == 1) {
+        indent(file, depth);
+
+        if (offset == keys->length) {
+            fprintf(file, "return %zu;\n", keys->index);
+            return;
+        }
+
+        fprintf(file, "return memcmp(&str[%zu], ", offset);
+        writeString(file, &keys->key[offset], keys->length - offset);
+        fprintf(file, ", %zu) ? -1 : %zu;\n", keys->length - offset, keys->index);
+        return;
+    }
+
+    indent(file, depth);
+    fprintf(file, "switch (str[%zu]) {\n", offset);
+
+    for (size_t begin = 0, end; begin < numberOfKeys; begin = end) {
+        for (end = begin + 1; end < numberOfKeys && keys[end].key[offset] == keys[begin].key[offset]; ++end)
+            ;
+
+        indent(file, depth);
+        fputs("case ", file);
+        writeCharacter(file, keys[begin].key[offset]);
+        fputs(":\n", file);
+        writeNameSwitch(file, &keys[begin], end - begin, offset + 1, depth + 1);
+    }
+
+    indent(file, depth);
+    fputs("default:\n", file);
+    indent(file, depth + 1);
+    fputs("return -1;\n", file);
+    indent(file, depth);
+    fputs("}\n", file);
+}
+
+static void
+writeHeader(
+    FILE *file,
+    char const *prefix
+) {
+    fprintf(file, "/* Generated by clarum_generate_parser() from %s, do not edit. */\n", CLARUM_SCHEMA);
+    fputs("#pragma once\n\n#include <clarum/clarum.h>\n\n", file);
+    fputs("#if defined(__cplusplus)\nextern \"C\" {\n#endif\n\n", file);
+
+    /* Indices let callers set value holders of particular options. */
+    fputs("enum {\n", file);
+    for (size_t i = 0; i < numberOfDefinitions; ++i)
+        fprintf(file, "    %s_%s,\n", prefix, definitions[i].identifier);
+    fprintf(file, "    %s_numberOfOptions,\n};\n\n", prefix);
+
+    fprintf(file, "/// Initializer of options array matching %s_parseOptions().\n", prefix);
+    fprintf(file, "#define %s_options { \\\n", prefix);
+    for (size_t i = 0; i < numberOfDefinitions; ++i) {
+        definition_t const
+            *definition = &definitions[i];
+        char const
+            *handler = getHandler(definition);
+
+        fputs("    {.tag = ", file);
+        writeCharacter(file, definition->tag);
+        fputs(", .name = ", file);
+        writeOptionalString(file, definition->name);
+        fputs(", .synonym = ", file);
+        writeOptionalString(file, definition->synonym);
+        fprintf(file, ", .handler = %s%s", handler ? "&" : "", handler ? handler : "NULL");
+        fprintf(file, ", .isRequired = %s, .isTerminal = %s}, \\\n",
+            definition->isRequired ? "true" : "false", definition->isTerminal ? "true" : "false");
+    }
+    fputs("}\n\n", file);
+
+    fprintf(file,
+        "/// Parses @p argc and @p argv exactly as cla_parseOptions() would.\n"
+        "///\n"
+        "/// @details\n"
+        "/// Parser options shall be initialized by %s_options;\n"
+        "/// handlers named by schema are called directly, so options may not override them.\n"
+        "///\n"
+        "/// @returns\n"
+        "/// Illegal input error when parser holds fewer than %s_numberOfOptions options,\n"
+        "/// otherwise same status as cla_parseOptions().\n"
+        "int\n"
+        "%s_parseOptions(\n"
+        "    cla_parser_t *parser,\n"
+        "    int argc,\n"
+        "    char **argv\n"
+        ");\n\n", prefix, prefix, prefix);
+
+    fprintf(file,
+        "/// Image of compiled index over %s_options, to be passed to cla_loadSchema().\n"
+        "///\n"
+        "/// @details\n"
+        "/// Image is empty when keys of options are not unique, since such schema cannot be compiled.\n"
+        "extern unsigned char const\n"
+        "    %s_schemaImage[];\n\n"
+        "/// Number of bytes in %s_schemaImage.\n"
+        "extern size_t const\n"
+        "    %s_schemaImageSize;\n\n", prefix, prefix, prefix, prefix);
+
+    fputs("#if defined(__cplusplus)\n}\n#endif\n", file);
+}
+
+/* Emits image of index compiled by the very library parsing with it. */
+static void
+writeImage(
+    FILE *file,
+    char const *prefix
+) {
+    static cla_slot_t
+        slots[cla_numberOfSlots(sizeof options / sizeof *options)];
+    cla_schema_t
+        schema = {
+            .options = options,
+            .numberOfOptions = numberOfDefinitions,
+            .slots = slots,
+            .numberOfSlots = cla_numberOfSlots(numberOfDefinitions),
+        };
+    size_t
+        size = cla_getSchemaImageSize(&schema);
+    /* Allocation is aligned for any type, hence for image header. */
+    unsigned char
+        *image = malloc(size);
+
+    if (!image || cla_compileSchema(&schema) || cla_saveSchema(&schema, image, size))
+        size = 0;
+
+    fprintf(file, "_Alignas(8) unsigned char const\n    %s_schemaImage[] = {", prefix);
+    for (size_t i = 0; i < size; ++i)
+        fprintf(file, "%s0x%02x,", i % 16 ? " " : "\n        ", image[i]);
+    fprintf(file, "%s};\n\nsize_t const\n    %s_schemaImageSize = %zu;\n", size ? "\n    " : "0", prefix, size);
+
+    free(image);
+}
+
+static void
+writeParser(
+    FILE *file,
+    char const *prefix
+) {
+    static entry_t
+        keys[2 * (sizeof definitions / sizeof *definitions)];
+    size_t const
+        numberOfKeys = makeKeys(keys),
+        numberOfWords = numberOfDefinitions ? (numberOfDefinitions + 63) / 64 : 1;
+
+    fprintf(file, "/* Generated by clarum_generate_parser() from %s, do not edit. */\n", CLARUM_SCHEMA);
+    fprintf(file, "#include \"%s.h\"\n#include <string.h>\n\n", prefix);
+
+    /* Handlers are resolved by linker, hence shall have external linkage. */
+    for (size_t i = 0; i < numberOfDefinitions; ++i) {
+        char const
+            *handler = getHandler(&definitions[i]);
+        bool
+            isDeclared = !handler;
+
+        for (size_t j = 0; j < i && !isDeclared; ++j) {
+            char const
+                *previous = getHandler(&definitions[j]);
+
+            isDeclared = previous && !strcmp(previous, handler);
+        }
+
+        if (!isDeclared)
+            fprintf(file, "cla_handler_t\n%s;\n\n", handler);
+    }
+
+    fputs(
+        "static inline bool\n"
+        "isEscapeCharacter(\n"
+        "    char chr\n"
+        ") {\n"
+        "    return chr == '-' || chr == '/';\n"
+        "}\n\n"
+        "static inline bool\n"
+        "isOptionCharacter(\n"
+        "    char chr\n"
+        ") {\n"
+        "    return chr && !isEscapeCharacter(chr) && chr != '=';\n"
+        "}\n\n", file);
+
+    /* Names resolve by length first, then character by character. */
+    fputs(
+        "static inline int\n"
+        "findName(\n"
+        "    char const *str,\n"
+        "    size_t length\n"
+        ") {\n", file);
+    if (!numberOfKeys)
+        fputs("    (void) str;\n\n", file);
+    fputs("    switch (length) {\n", file);
+    for (size_t begin = 0, end; begin < numberOfKeys; begin = end) {
+        for (end = begin + 1; end < numberOfKeys && keys[end].length == keys[begin].length; ++end)
+            ;
+
+        fprintf(file, "    case %zu:\n", keys[begin].length);
+        writeNameSwitch(file, &keys[begin], end - begin, 0, 2);
+    }
+    fputs(
+        "    default:\n"
+        "        return -1;\n"
+        "    }\n"
+        "}\n\n", file);
+
+    fputs(
+        "static inline int\n"
+        "findTag(\n"
+        "    char chr\n"
+        ") {\n"
+        "    switch (chr) {\n", file);
+    for (size_t i = 0; i < numberOfDefinitions; ++i) {
+        bool
+            isShadowed = !definitions[i].tag;
+
+        for (size_t j = 0; j < i && !isShadowed; ++j)
+            isShadowed = definitions[j].tag == definitions[i].tag;
+
+        if (!isShadowed) {
+            fputs("    case ", file);
+            writeCharacter(file, definitions[i].tag);
+            fprintf(file, ":\n        return %zu;\n", i);
+        }
+    }
+    fputs(
+        "    default:\n"
+        "        return -1;\n"
+        "    }\n"
+        "}\n\n", file);
+
+    fputs(
+        "static inline int\n"
+        "referenceOption(\n"
+        "    cla_parser_t *parser,\n"
+        "    uint64_t *references,\n"
+        "    int index,\n"
+        "    char *value,\n"
+        "    size_t valueLength\n"
+        ") {\n"
+        "    cla_option_t\n"
+        "        *option = &parser->options[index];\n\n"
+        "    references[index / 64] |= (uint64_t) 1 << (index % 64);\n"
+        "    option->isReferenced = true;\n"
+        "    option->argument = value;\n"
+        "    option->argumentLength = valueLength;\n\n"
+        "    switch (index) {\n", file);
+    for (size_t i = 0; i < numberOfDefinitions; ++i) {
+        char const
+            *handler = getHandler(&definitions[i]);
+
+        fprintf(file, "    case %zu:\n", i);
+        fprintf(file, "        parser->isTerminated = %s;\n", definitions[i].isTerminal ? "true" : "false");
+        if (handler)
+            fprintf(file, "        return %s(parser, option);\n", handler);
+        else
+            fputs("        return cla_noErrors;\n", file);
+    }
+    fputs(
+        "    default:\n"
+        "        return cla_noErrors;\n"
+        "    }\n"
+        "}\n\n", file);
+
+    fputs(
+        "static inline int\n"
+        "parseOption(\n"
+        "    cla_parser_t *parser,\n"
+        "    uint64_t *references,\n"
+        "    char const *str,\n"
+        "    size_t length,\n"
+        "    char *value,\n"
+        "    size_t valueLength,\n"
+        "    bool byTag\n"
+        ") {\n"
+        "    int\n"
+        "        index;\n\n"
+        "    if (!length)\n"
+        "        /* @str = '--\\0' is skipped, while '--=value' is malformed. */\n"
+        "        return value\n"
+        "            ? cla_illegalInputError\n"
+        "            : cla_noErrors;\n\n"
+        "    if (!isOptionCharacter(str[0]))\n"
+        "        /* @str has invalid syntax. */\n"
+        "        return cla_illegalInputError;\n\n"
+        "    index = byTag\n"
+        "        ? findTag(str[0])\n"
+        "        : findName(str, length);\n\n"
+        "    if (index < 0) {\n"
+        "        return !parser->isLenient\n"
+        "            ? parser->isTerminated = true, cla_unknowOptionError\n"
+        "            : cla_noErrors;\n"
+        "    }\n\n"
+        "    return referenceOption(parser, references, index, value, valueLength);\n"
+        "}\n\n", file);
+
+    fputs(
+        "static inline int\n"
+        "parseArgument(\n"
+        "    cla_parser_t *parser,\n"
+        "    uint64_t *references,\n"
+        "    char *argument\n"
+        ") {\n"
+        "    char\n"
+        "        *value = strchr(argument, '=');\n"
+        "    size_t const\n"
+        "        length = value ? (size_t) (value - argument) : strlen(argument),\n"
+        "        valueLength = value ? strlen(++value) : 0;\n\n"
+        "    if (!length || !isEscapeCharacter(argument[0])) {\n"
+        "        /* Not a valid option. */\n"
+        "        parser->next = argument;\n"
+        "        return cla_noErrors;\n"
+        "    }\n\n"
+        "    if (length == 1 || !isEscapeCharacter(argument[1])) {\n"
+        "        int\n"
+        "            status = cla_noErrors;\n\n"
+        "        /* Short '-x' or '-abc' form, whole group shares single value. */\n"
+        "        for (size_t i = 1; i < length && isOptionCharacter(argument[i]) && !status; ++i)\n"
+        "            status = parseOption(parser, references, &argument[i], 1, value, valueLength, true);\n\n"
+        "        return status;\n"
+        "    }\n\n"
+        "    /* Long '--name' form. */\n"
+        "    return parseOption(parser, references, &argument[2], length - 2, value, valueLength, false);\n"
+        "}\n\n", file);
+
+    /* Required options missing from bitset are checked against flags, which may be preset. */
+    fputs(
+        "static inline bool\n"
+        "isRequiredOptionMissing(\n"
+        "    cla_option_t const *options,\n"
+        "    uint64_t const *references\n"
+        ") {\n", file);
+    for (size_t word = 0; word < numberOfWords; ++word) {
+        unsigned long long
+            mask = 0;
+
+        for (size_t i = word * 64; i < numberOfDefinitions && i < word * 64 + 64; ++i)
+            mask |= (unsigned long long) definitions[i].isRequired << (i % 64);
+
+        if (!mask)
+            continue;
+
+        fprintf(file, "    if ((references[%zu] & 0x%llxu) != 0x%llxu) {\n", word, mask, mask);
+        for (size_t i = word * 64; i < numberOfDefinitions && i < word * 64 + 64; ++i) {
+            if (definitions[i].isRequired)
+                fprintf(file, "        if (!options[%zu].isReferenced)\n            return true;\n", i);
+        }
+        fputs("    }\n\n", file);
+    }
+    fputs(
+        "    (void) options, (void) references;\n"
+        "    return false;\n"
+        "}\n\n", file);
+
+    fprintf(file,
+        "int\n"
+        "%s_parseOptions(\n"
+        "    cla_parser_t *parser,\n"
+        "    int argc,\n"
+        "    char **argv\n"
+        ") {\n"
+        "    uint64_t\n"
+        "        references[%zu] = {0};\n\n"
+        "    if (!parser || !argv)\n"
+        "        /* Null @parser or @argv. */\n"
+        "        return cla_nullReferenceError;\n\n"
+        "    if (parser->numberOfOptions < %zu)\n"
+        "        /* Options were not initialized by %s_options. */\n"
+        "        return cla_illegalInputError;\n\n"
+        "    if (argc > 1) {\n"
+        "        parser->next = NULL;\n\n"
+        "        /* Skips first argument (binary name). */\n"
+        "        for (--argc, ++argv; argc-- && !parser->isTerminated && !parser->next; ++argv) {\n"
+        "            int const\n"
+        "                status = parseArgument(parser, references, *argv);\n\n"
+        "            if (status)\n"
+        "                return status;\n"
+        "        }\n\n"
+        "        if (isRequiredOptionMissing(parser->options, references))\n"
+        "            return cla_missingOptionError;\n"
+        "    }\n\n"
+        "    return cla_noErrors;\n"
+        "}\n", prefix, numberOfWords, numberOfDefinitions, prefix);
+}
+
+int
+main(int argc, char **argv) {
+    FILE
+        *source,
+        *header;
+
+    if (argc != 4) {
+        fprintf(stderr, "usage: %s prefix source header\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    source = fopen(argv[2], "w");
+    header = fopen(argv[3], "w");
+
+    if (!source || !header) {
+        fprintf(stderr, "%s: cannot write parser files\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    writeHeader(header, argv[1]);
+    writeParser(source, argv[1]);
+    fputc('\n', source);
+    writeImage(source, argv[1]);
+
+    if (fclose(source) | fclose(header)) {
+        fprintf(stderr, "%s: cannot write parser files\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
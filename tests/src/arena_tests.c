@@ -0,0 +1,135 @@
+#include <clarum/clarum.h>
+#include <snow/snow.h>
+#include <stdint.h>
+
+static size_t
+    numberOfBlocks;
+
+static void *
+countingAllocator(
+    void *context,
+    void *block,
+    size_t size
+) {
+    size_t
+        *limit = context;
+
+    if (block) {
+        --numberOfBlocks;
+        return cla_heapAllocator(NULL, block, size);
+    }
+
+    if (numberOfBlocks == *limit)
+        return NULL;
+
+    ++numberOfBlocks;
+    return cla_heapAllocator(NULL, NULL, size);
+}
+
+describe(arena) {
+    it("allocates aligned memory from caller-supplied buffer only") {
+        char
+            buffer[100];
+        cla_arena_t
+            arena = {
+                /* Misaligned on purpose. */
+                .buffer = buffer + 1,
+                .bufferSize = sizeof buffer - 1,
+            };
+        void
+            *first,
+            *second;
+
+        asserteq_ptr(cla_allocate(NULL, 1), NULL, "@arena was not checked for NULL");
+
+        first = cla_allocate(&arena, 1);
+        second = cla_allocate(&arena, 24);
+        assert(first && second);
+        asserteq((uintptr_t) first % 16, 0, "allocation was not aligned");
+        asserteq((uintptr_t) second % 16, 0, "allocation was not aligned");
+        assert((char *) second >= (char *) first + 16);
+        assert((char *) second + 24 <= buffer + sizeof buffer);
+        asserteq_ptr(cla_allocate(&arena, 64), NULL, "fixed-size arena was overrun");
+
+        cla_resetArena(&arena);
+        asserteq_ptr(cla_allocate(&arena, 1), first, "buffer was not reused after reset");
+    }
+
+    it("grows through allocator and returns blocks on reset") {
+        size_t
+            limit = 3;
+        char
+            buffer[64];
+        cla_arena_t
+            arena = {
+                .buffer = buffer,
+                .bufferSize = sizeof buffer,
+                .allocator = &countingAllocator,
+                .context = &limit,
+            };
+
+        numberOfBlocks = 0;
+        assert(cla_allocate(&arena, 32));
+        asserteq(numberOfBlocks, 0, "block was grown while buffer had room");
+        assert(cla_allocate(&arena, 4000));
+        asserteq(numberOfBlocks, 1, "block was not grown");
+        assert(cla_allocate(&arena, 100000));
+        asserteq(numberOfBlocks, 2, "large allocation did not get its own block");
+        assert(cla_allocate(&arena, 1000000));
+        asserteq_ptr(cla_allocate(&arena, 10000000), NULL, "allocator failure was not reported");
+
+        cla_resetArena(&arena);
+        asserteq(numberOfBlocks, 0, "blocks were not returned");
+    }
+
+    it("bounds list storage by arena") {
+        char
+            *argv[] = {"binary", "--value=1,2,3,4,5,6,7,8,9"},
+            *arguments[1];
+        _Alignas(16) char
+            buffer[32];
+        uint64_t
+            references[cla_numberOfWords(1)];
+        cla_list_t
+            values = {
+                .separator = ',',
+            };
+        cla_option_t
+            options[] = {{
+                    .name = "value",
+                    .handler = &cla_int32ListHandler,
+                    .valuePtr = &values,
+                },
+            };
+        cla_slot_t
+            slots[cla_numberOfSlots(1)];
+        cla_schema_t
+            schema = {
+                .options = options,
+                .numberOfOptions = sizeof options / sizeof *options,
+                .slots = slots,
+                .numberOfSlots = sizeof slots / sizeof *slots,
+            };
+        cla_result_t
+            result = {
+                .arguments = arguments,
+                .references = references,
+                .arena = {
+                    .buffer = buffer,
+                    .bufferSize = sizeof buffer,
+                },
+            },
+            empty = {
+                .arguments = arguments,
+                .references = references,
+            };
+
+        asserteq(cla_compileSchema(&schema), cla_noErrors);
+        asserteq(cla_parse(&schema, &result, 2, argv), cla_outOfMemoryError, "arena was overrun");
+        asserteq(values.numberOfItems, 8, "list did not fill arena");
+
+        cla_releaseResult(&result);
+        asserteq(cla_parse(&schema, &empty, 2, argv), cla_outOfMemoryError, "list was filled without storage");
+        asserteq(values.numberOfItems, 0);
+    }
+}
@@ -0,0 +1,127 @@
+#include <clarum/clarum.h>
+#include <snow/snow.h>
+#include <stdio.h>
+
+describe(batch) {
+    it("checks for null pointers") {
+        cla_schema_t
+            schema = {
+                .numberOfOptions = 0,
+            };
+        cla_invocation_t
+            invocations[1];
+        cla_result_t
+            results[1];
+
+        asserteq(cla_parseBatch(NULL, invocations, results, 1, 1), cla_nullReferenceError, "@schema was not checked for NULL");
+        asserteq(cla_parseBatch(&schema, NULL, results, 1, 1), cla_nullReferenceError, "@invocations was not checked for NULL");
+        asserteq(cla_parseBatch(&schema, invocations, NULL, 1, 1), cla_nullReferenceError, "@results was not checked for NULL");
+    }
+
+    it("parses every invocation and reports failures separately") {
+        enum {
+            numberOfInvocations = 1000,
+        };
+        static char
+            values[numberOfInvocations][32],
+            *argvs[numberOfInvocations][2],
+            *arguments[numberOfInvocations][1];
+        static uint64_t
+            references[numberOfInvocations][cla_numberOfWords(1)];
+        static size_t
+            jobs[numberOfInvocations];
+        static void
+            *holders[numberOfInvocations][1];
+        static cla_invocation_t
+            invocations[numberOfInvocations];
+        static cla_result_t
+            results[numberOfInvocations];
+        cla_option_t
+            options[] = {{
+                    .name = "jobs",
+                    .handler = &cla_integerHandler,
+                },
+            };
+        cla_slot_t
+            slots[cla_numberOfSlots(1)];
+        cla_schema_t
+            schema = {
+                .options = options,
+                .numberOfOptions = sizeof options / sizeof *options,
+                .slots = slots,
+                .numberOfSlots = sizeof slots / sizeof *slots,
+            };
+
+        for (size_t i = 0; i < numberOfInvocations; ++i) {
+            /* Every seventh invocation carries unknown option. */
+            snprintf(values[i], sizeof values[i], i % 7 ? "--jobs=%zu" : "--job=%zu", i);
+            argvs[i][0] = "binary";
+            argvs[i][1] = values[i];
+            holders[i][0] = &jobs[i];
+            invocations[i] = (cla_invocation_t) {
+                .argc = 2,
+                .argv = argvs[i],
+            };
+            results[i] = (cla_result_t) {
+                .arguments = arguments[i],
+                .references = references[i],
+                .values = holders[i],
+            };
+        }
+
+        asserteq(cla_compileSchema(&schema), cla_noErrors);
+        asserteq(cla_parseBatch(&schema, invocations, results, numberOfInvocations, 4), cla_noErrors);
+
+        for (size_t i = 0; i < numberOfInvocations; ++i) {
+            if (i % 7) {
+                asserteq(results[i].status, cla_noErrors, "valid invocation was not parsed");
+                asserteq(jobs[i], i, "option value was not decoded");
+            } else {
+                asserteq(results[i].status, cla_unknowOptionError, "invalid invocation was not reported");
+                asserteq(cla_isReferenced(&results[i], 0), false, "unknown option was reported as referenced");
+            }
+        }
+    }
+
+    it("reports null argv of invocation whose result is reused") {
+        char
+            *argv[] = {"binary", "--jobs=1"},
+            *arguments[1];
+        uint64_t
+            references[cla_numberOfWords(1)];
+        cla_option_t
+            options[] = {{
+                    .name = "jobs",
+                },
+            };
+        cla_slot_t
+            slots[cla_numberOfSlots(1)];
+        cla_schema_t
+            schema = {
+                .options = options,
+                .numberOfOptions = sizeof options / sizeof *options,
+                .slots = slots,
+                .numberOfSlots = sizeof slots / sizeof *slots,
+            };
+        cla_invocation_t
+            invocations[] = {{
+                    .argc = 2,
+                    .argv = argv,
+                },
+            };
+        cla_result_t
+            results[] = {{
+                    .arguments = arguments,
+                    .references = references,
+                },
+            };
+
+        asserteq(cla_compileSchema(&schema), cla_noErrors);
+        asserteq(cla_parseBatch(&schema, invocations, results, 1, 1), cla_noErrors);
+        asserteq(results[0].status, cla_noErrors);
+
+        invocations[0].argv = NULL;
+        asserteq(cla_parseBatch(&schema, invocations, results, 1, 1), cla_noErrors);
+        asserteq(results[0].status, cla_nullReferenceError, "null argv was reported as success");
+    }
+}
@@ -0,0 +1,215 @@
+#include <clarum/clarum.h>
+#include <snow/snow.h>
+#include <string.h>
+
+/* Stores length of argument, as measured by custom handler unaware of cla_option_t::argumentLength. */
+static int
+measureString(
+    cla_parser_t *parser,
+    cla_option_t *option
+) {
+    (void) parser;
+
+    *(size_t *) option->valuePtr = strlen(option->argument);
+    return cla_noErrors;
+}
+
+describe(buffer) {
+    it("checks for null pointers") {
+        char
+            *arguments[1];
+        uint64_t
+            references[1];
+        cla_option_t
+            options[] = {{
+                    .name = "foo",
+                },
+            };
+        cla_slot_t
+            slots[cla_numberOfSlots(1)];
+        cla_schema_t
+            schema = {
+                .options = options,
+                .numberOfOptions = sizeof options / sizeof *options,
+                .slots = slots,
+                .numberOfSlots = sizeof slots / sizeof *slots,
+            };
+        cla_result_t
+            result = {
+                .arguments = arguments,
+                .references = references,
+            };
+
+        asserteq(cla_compileSchema(&schema), cla_noErrors);
+        asserteq(cla_parseBuffer(NULL, &result, "", 1), cla_nullReferenceError, "@schema was not checked for NULL");
+        asserteq(cla_parseBuffer(&schema, NULL, "", 1), cla_nullReferenceError, "@result was not checked for NULL");
+        asserteq(cla_parseBuffer(&schema, &result, NULL, 1), cla_nullReferenceError, "@buffer was not checked for NULL");
+        asserteq(cla_parseBuffer(&schema, &result, NULL, 0), cla_noErrors, "empty buffer was not accepted");
+    }
+
+    it("parses NUL-separated arguments") {
+        char const
+            buffer[] = "binary\0--jobs=12\0-v\0--name=foo\0operand\0--jobs=1";
+        char
+            *arguments[3],
+            *name = NULL;
+        uint64_t
+            references[cla_numberOfWords(3)];
+        size_t
+            jobs = 0;
+        bool
+            isVerbose = false;
+        cla_option_t
+            options[] = {{
+                    .name = "jobs",
+                    .handler = &cla_integerHandler,
+                    .valuePtr = &jobs,
+                }, {
+                    .tag = 'v',
+                    .handler = &cla_booleanHandler,
+                    .valuePtr = &isVerbose,
+                }, {
+                    .name = "name",
+                    .handler = &cla_stringHandler,
+                    .valuePtr = &name,
+                },
+            };
+        cla_slot_t
+            slots[cla_numberOfSlots(3)];
+        cla_schema_t
+            schema = {
+                .options = options,
+                .numberOfOptions = sizeof options / sizeof *options,
+                .slots = slots,
+                .numberOfSlots = sizeof slots / sizeof *slots,
+            };
+        cla_result_t
+            result = {
+                .arguments = arguments,
+                .references = references,
+            };
+
+        asserteq(cla_compileSchema(&schema), cla_noErrors);
+        asserteq(cla_parseBuffer(&schema, &result, buffer, sizeof buffer), cla_noErrors);
+        asserteq(jobs, 12, "integer option value was not decoded");
+        asserteq(isVerbose, true, "boolean option value was not decoded");
+        asserteq_str(name, "foo", "string option value was not set");
+        asserteq_str(result.next, "operand", "first unprocessed option was not recorded");
+    }
+
+    it("parses last argument without terminator") {
+        char
+            buffer[] = "binary\0--bool=on\0--jobs=42XXXX",
+            *arguments[2];
+        _Alignas(16) char
+            storage[64];
+        uint64_t
+            references[cla_numberOfWords(2)];
+        size_t
+            jobs = 0;
+        bool
+            value = false;
+        cla_option_t
+            options[] = {{
+                    .name = "jobs",
+                    .handler = &cla_integerHandler,
+                    .valuePtr = &jobs,
+                }, {
+                    .name = "bool",
+                    .handler = &cla_booleanHandler,
+                    .valuePtr = &value,
+                },
+            };
+        cla_slot_t
+            slots[cla_numberOfSlots(2)];
+        cla_schema_t
+            schema = {
+                .options = options,
+                .numberOfOptions = sizeof options / sizeof *options,
+                .slots = slots,
+                .numberOfSlots = sizeof slots / sizeof *slots,
+            };
+        cla_result_t
+            result = {
+                .arguments = arguments,
+                .references = references,
+                .arena = {
+                    .buffer = storage,
+                    .bufferSize = sizeof storage,
+                },
+            };
+
+        asserteq(cla_compileSchema(&schema), cla_noErrors);
+        /* Excludes trailing 'XXXX' and terminator. */
+        asserteq(cla_parseBuffer(&schema, &result, buffer, sizeof buffer - 5), cla_noErrors);
+        asserteq(jobs, 42, "last option value was not bounded by buffer length");
+        asserteq(value, true, "boolean option value was not decoded");
+        asserteq(cla_isReferenced(&result, 0), true, "last option was not reported as referenced");
+    }
+
+    it("copies unterminated last argument into result arena") {
+        char
+            buffer[] = "binary\0--jobs=1\0--name=fooXXXX",
+            label[] = "binary\0--label=barXXXX",
+            operand[] = "binary\0--name=foo\0fileXXXX",
+            *arguments[3];
+        _Alignas(16) char
+            storage[64];
+        uint64_t
+            references[cla_numberOfWords(3)];
+        size_t
+            length = 0;
+        char const
+            *name = NULL;
+        cla_option_t
+            options[] = {{
+                    .name = "jobs",
+                    .handler = &cla_integerHandler,
+                    .valuePtr = &length,
+                }, {
+                    .name = "name",
+                    .handler = &measureString,
+                    .valuePtr = &length,
+                }, {
+                    .name = "label",
+                    .handler = &cla_stringHandler,
+                    .valuePtr = &name,
+                },
+            };
+        cla_slot_t
+            slots[cla_numberOfSlots(3)];
+        cla_schema_t
+            schema = {
+                .options = options,
+                .numberOfOptions = sizeof options / sizeof *options,
+                .slots = slots,
+                .numberOfSlots = sizeof slots / sizeof *slots,
+            };
+        cla_result_t
+            result = {
+                .arguments = arguments,
+                .references = references,
+            };
+
+        asserteq(cla_compileSchema(&schema), cla_noErrors);
+        /* Excludes trailing 'XXXX' and terminator. */
+        asserteq(cla_parseBuffer(&schema, &result, buffer, sizeof buffer - 5), cla_outOfMemoryError,
+            "unterminated argument was handed out without arena");
+
+        result.arena = (cla_arena_t) {
+            .buffer = storage,
+            .bufferSize = sizeof storage,
+        };
+
+        asserteq(cla_parseBuffer(&schema, &result, buffer, sizeof buffer - 5), cla_noErrors);
+        asserteq(length, 3, "custom handler read past buffer end");
+        assert(result.arguments[1] >= storage && result.arguments[1] < storage + sizeof storage,
+            "unterminated argument was not copied");
+
+        asserteq(cla_parseBuffer(&schema, &result, label, sizeof label - 5), cla_noErrors);
+        asserteq_str(name, "bar", "string value was not terminated");
+
+        asserteq(cla_parseBuffer(&schema, &result, operand, sizeof operand - 5), cla_noErrors);
+        asserteq_str(result.next, "file", "operand was not terminated");
+    }
+}
@@ -0,0 +1,332 @@
+#include <clarum/clarum.h>
+#include <snow/snow.h>
+#include <string.h>
+
+static size_t
+    numberOfCalls;
+
+static int
+countingHandler(
+    cla_parser_t *parser,
+    cla_option_t *option
+) {
+    ++numberOfCalls;
+    return cla_integerHandler(parser, option);
+}
+
+describe(cache) {
+    it("checks for null pointers and storage layout") {
+        char
+            *argv[] = {"binary", "--jobs=1"},
+            *arguments[1];
+        uint64_t
+            storage[64],
+            references[cla_numberOfWords(1)];
+        size_t
+            argumentLengths[1];
+        cla_option_t
+            options[] = {{
+                    .name = "jobs",
+                },
+            };
+        cla_slot_t
+            slots[cla_numberOfSlots(1)];
+        cla_schema_t
+            schema = {
+                .options = options,
+                .numberOfOptions = sizeof options / sizeof *options,
+                .slots = slots,
+                .numberOfSlots = sizeof slots / sizeof *slots,
+            };
+        cla_cache_t
+            cache = {
+                .storage = storage,
+                .numberOfEntries = 1,
+                .entrySize = 8,
+            };
+        cla_result_t
+            result = {
+                .arguments = arguments,
+                .references = references,
+            };
+
+        asserteq(cla_compileSchema(&schema), cla_noErrors);
+        asserteq(cla_getCacheEntrySize(NULL), 0);
+        asserteq(cla_parseCached(NULL, &cache, &result, 2, argv), cla_nullReferenceError, "@schema was not checked for NULL");
+        asserteq(cla_parseCached(&schema, NULL, &result, 2, argv), cla_nullReferenceError, "@cache was not checked for NULL");
+        asserteq(cla_parseCached(&schema, &cache, NULL, 2, argv), cla_nullReferenceError, "@result was not checked for NULL");
+        asserteq(cla_parseCached(&schema, &cache, &result, 2, NULL), cla_nullReferenceError, "@argv was not checked for NULL");
+        asserteq(cla_parseCached(&schema, &cache, &result, 2, argv), cla_illegalInputError, "small entries were accepted");
+
+        cache.entrySize = cla_getCacheEntrySize(&schema);
+        cache.storage = (char *) storage + 4;
+        asserteq(cla_parseCached(&schema, &cache, &result, 2, argv), cla_illegalInputError, "misaligned storage was accepted");
+
+        cache.storage = storage;
+        result.argumentLengths = argumentLengths;
+        asserteq(cla_parseCached(&schema, &cache, &result, 2, argv), cla_illegalInputError, "lazy result was accepted");
+    }
+
+    it("restores values and arguments without running copied handlers") {
+        char
+            first[][16] = {"binary", "--jobs=4", "-v", "--name=x", "target"},
+            second[][16] = {"binary", "--jobs=4", "-v", "--name=x", "target"},
+            *firstArgv[] = {first[0], first[1], first[2], first[3], first[4]},
+            *secondArgv[] = {second[0], second[1], second[2], second[3], second[4]},
+            *arguments[4];
+        uint64_t
+            storage[4][32] = {{0}},
+            references[cla_numberOfWords(4)];
+        unsigned char
+            sources[4];
+        size_t
+            jobs = 0,
+            depth = 0;
+        bool
+            isVerbose = false;
+        char const
+            *name = NULL;
+        cla_option_t
+            options[] = {{
+                    .name = "jobs",
+                    .handler = &countingHandler,
+                    .valuePtr = &jobs,
+                    .valueSize = sizeof jobs,
+                }, {
+                    .tag = 'v',
+                    .name = "verbose",
+                    .handler = &cla_booleanHandler,
+                    .valuePtr = &isVerbose,
+                    .valueSize = sizeof isVerbose,
+                }, {
+                    .name = "name",
+                    .handler = &cla_stringHandler,
+                    .valuePtr = &name,
+                }, {
+                    .name = "depth",
+                    .handler = &countingHandler,
+                    .valuePtr = &depth,
+                    .valueSize = sizeof depth,
+                },
+            };
+        cla_slot_t
+            slots[cla_numberOfSlots(4)];
+        cla_schema_t
+            schema = {
+                .options = options,
+                .numberOfOptions = sizeof options / sizeof *options,
+                .slots = slots,
+                .numberOfSlots = sizeof slots / sizeof *slots,
+            };
+        cla_cache_t
+            cache = {
+                .storage = storage,
+                .numberOfEntries = sizeof storage / sizeof *storage,
+                .entrySize = sizeof *storage,
+            };
+        cla_result_t
+            result = {
+                .arguments = arguments,
+                .references = references,
+                .sources = sources,
+            };
+
+        asserteq(cla_compileSchema(&schema), cla_noErrors);
+        assert(cla_getCacheEntrySize(&schema) <= cache.entrySize);
+
+        numberOfCalls = 0;
+        asserteq(cla_parseCached(&schema, &cache, &result, 5, firstArgv), cla_noErrors);
+        asserteq(cache.numberOfMisses, 1);
+        asserteq(numberOfCalls, 1);
+
+        jobs = 0;
+        isVerbose = false;
+        name = NULL;
+        asserteq(cla_parseCached(&schema, &cache, &result, 5, secondArgv), cla_noErrors);
+        asserteq(cache.numberOfHits, 1, "equal command line was not found");
+        asserteq(numberOfCalls, 1, "handler of copied value ran on hit");
+        asserteq(jobs, 4);
+        assert(isVerbose);
+        asserteq_ptr(name, &second[3][7], "handler without value size did not run on new arguments");
+        asserteq_ptr(result.arguments[0], &second[1][7], "argument was not relocated");
+        asserteq_ptr(result.arguments[1], NULL);
+        asserteq_ptr(result.next, second[4]);
+        asserteq(sources[0], cla_argumentSource);
+        assert(cla_isReferenced(&result, 2) && !cla_isReferenced(&result, 3));
+
+        strcpy(second[1], "--jobs=5");
+        asserteq(cla_parseCached(&schema, &cache, &result, 5, secondArgv), cla_noErrors);
+        asserteq(cache.numberOfMisses, 2, "changed command line was found");
+        asserteq(jobs, 5);
+    }
+
+    it("rejects stored positions past end of arguments") {
+        char
+            *argv[] = {"binary", "--name=foo"},
+            *arguments[1];
+        uint64_t
+            storage[1][16] = {{0}},
+            references[cla_numberOfWords(1)],
+            position = (uint64_t) 1 << 32 | 7;
+        char const
+            *name = NULL;
+        cla_option_t
+            options[] = {{
+                    .name = "name",
+                    .handler = &cla_stringHandler,
+                    .valuePtr = &name,
+                },
+            };
+        cla_slot_t
+            slots[cla_numberOfSlots(1)];
+        cla_schema_t
+            schema = {
+                .options = options,
+                .numberOfOptions = 1,
+                .slots = slots,
+                .numberOfSlots = sizeof slots / sizeof *slots,
+            };
+        cla_cache_t
+            cache = {
+                .storage = storage,
+                .numberOfEntries = 1,
+                .entrySize = sizeof *storage,
+            };
+        cla_result_t
+            result = {
+                .arguments = arguments,
+                .references = references,
+            };
+        size_t
+            numberOfPositions = 0;
+
+        asserteq(cla_compileSchema(&schema), cla_noErrors);
+        asserteq(cla_parseCached(&schema, &cache, &result, 2, argv), cla_noErrors);
+
+        /* Imitates entry of colliding command line, whose value starts further in argument. */
+        for (size_t i = 0; i < sizeof *storage / sizeof **storage; ++i) {
+            if (storage[0][i] == position) {
+                storage[0][i] = position + 100;
+                ++numberOfPositions;
+            }
+        }
+
+        asserteq(numberOfPositions, 1);
+        asserteq(cla_parseCached(&schema, &cache, &result, 2, argv), cla_noErrors);
+        asserteq(cache.numberOfHits, 0, "position past end of argument was restored");
+        asserteq_ptr(name, argv[1] + 7);
+    }
+
+    it("never caches options with side effects, nor results depending on environment") {
+        char
+            *argv[] = {"binary", "--jobs=4"},
+            *environment[] = {NULL},
+            *arguments[1];
+        uint64_t
+            storage[2][16] = {{0}},
+            references[cla_numberOfWords(1)];
+        size_t
+            jobs = 0;
+        cla_option_t
+            options[] = {{
+                    .name = "jobs",
+                    .handler = &countingHandler,
+                    .valuePtr = &jobs,
+                    .valueSize = sizeof jobs,
+                    .hasSideEffects = true,
+                },
+            };
+        cla_slot_t
+            slots[cla_numberOfSlots(1)];
+        cla_schema_t
+            schema = {
+                .options = options,
+                .numberOfOptions = 1,
+                .slots = slots,
+                .numberOfSlots = sizeof slots / sizeof *slots,
+            };
+        cla_cache_t
+            cache = {
+                .storage = storage,
+                .numberOfEntries = 2,
+                .entrySize = sizeof *storage,
+            };
+        cla_result_t
+            result = {
+                .arguments = arguments,
+                .references = references,
+            };
+
+        asserteq(cla_compileSchema(&schema), cla_noErrors);
+
+        numberOfCalls = 0;
+        for (int i = 0; i < 3; ++i)
+            asserteq(cla_parseCached(&schema, &cache, &result, 2, argv), cla_noErrors);
+
+        asserteq(numberOfCalls, 3, "handler with side effects was skipped");
+        asserteq(cache.numberOfHits, 0);
+        asserteq(cache.numberOfMisses, 3);
+
+        result.environment = environment;
+        asserteq(cla_parseCached(&schema, &cache, &result, 2, argv), cla_noErrors);
+        asserteq(cache.numberOfMisses, 3, "result depending on environment was looked up");
+    }
+
+    it("never caches list options") {
+        char
+            *argv[] = {"binary", "--size=1", "--size=2,3"},
+            *arguments[1];
+        _Alignas(16) char
+            buffer[256];
+        uint64_t
+            storage[2][16] = {{0}},
+            references[cla_numberOfWords(1)];
+        cla_list_t
+            sizes = {
+                .separator = ',',
+            };
+        cla_option_t
+            options[] = {{
+                    .name = "size",
+                    .handler = &cla_uint64ListHandler,
+                    .valuePtr = &sizes,
+                    .valueSize = sizeof sizes,
+                },
+            };
+        cla_slot_t
+            slots[cla_numberOfSlots(1)];
+        cla_schema_t
+            schema = {
+                .options = options,
+                .numberOfOptions = 1,
+                .slots = slots,
+                .numberOfSlots = sizeof slots / sizeof *slots,
+            };
+        cla_cache_t
+            cache = {
+                .storage = storage,
+                .numberOfEntries = 2,
+                .entrySize = sizeof *storage,
+            };
+        cla_result_t
+            result = {
+                .arguments = arguments,
+                .references = references,
+                .arena = {
+                    .buffer = buffer,
+                    .bufferSize = sizeof buffer,
+                },
+            };
+
+        asserteq(cla_compileSchema(&schema), cla_noErrors);
+        asserteq(cla_getCacheEntrySize(&schema) <= sizeof *storage, true);
+
+        for (int i = 0; i < 2; ++i) {
+            asserteq(cla_parseCached(&schema, &cache, &result, 3, argv), cla_noErrors);
+            asserteq(sizes.numberOfItems, 3, "earlier items were lost");
+            asserteq(((uint64_t const *) sizes.items)[2], 3);
+        }
+
+        asserteq(cache.numberOfHits, 0, "list option was cached");
+    }
+}
@@ -0,0 +1,222 @@
+#include <clarum/clarum.h>
+#include <snow/snow.h>
+
+describe(command) {
+    it("checks for null pointers") {
+        char
+            *argv[] = {"binary", "build"};
+        cla_command_t
+            commands[1] = {{
+                    .name = "build",
+                },
+            },
+            *command;
+        cla_slot_t
+            slots[cla_numberOfSlots(1)];
+        cla_dispatcher_t
+            dispatcher = {
+                .commands = commands,
+                .numberOfCommands = 1,
+                .slots = slots,
+                .numberOfSlots = sizeof slots / sizeof *slots,
+            };
+        cla_result_t
+            result = {
+                .numberOfRequiredReferences = 0,
+            };
+
+        asserteq(cla_compileDispatcher(NULL), cla_nullReferenceError, "@dispatcher was not checked for NULL");
+        asserteq(cla_compileDispatcher(&dispatcher), cla_nullReferenceError, "command schema was not checked for NULL");
+        asserteq(cla_dispatch(NULL, NULL, &result, 2, argv, &command), cla_nullReferenceError, "@dispatcher was not checked for NULL");
+        asserteq(cla_dispatch(&dispatcher, NULL, NULL, 2, argv, &command), cla_nullReferenceError, "@commandResult was not checked for NULL");
+        asserteq(cla_dispatch(&dispatcher, NULL, &result, 2, argv, NULL), cla_nullReferenceError, "@command was not checked for NULL");
+    }
+
+    it("rejects insufficient slots, empty, and duplicate names") {
+        cla_schema_t
+            schema = {
+                .numberOfOptions = 0,
+            };
+        cla_command_t
+            commands[2] = {{
+                    .name = "build",
+                    .schema = &schema,
+                }, {
+                    .name = "build",
+                    .schema = &schema,
+                },
+            };
+        cla_slot_t
+            slots[cla_numberOfSlots(2)];
+        cla_dispatcher_t
+            dispatcher = {
+                .commands = commands,
+                .numberOfCommands = 2,
+                .slots = slots,
+                .numberOfSlots = sizeof slots / sizeof *slots - 1,
+            };
+
+        asserteq(cla_compileDispatcher(&dispatcher), cla_illegalInputError, "insufficient slots were accepted");
+        dispatcher.numberOfSlots = sizeof slots / sizeof *slots;
+        asserteq(cla_compileDispatcher(&dispatcher), cla_illegalInputError, "duplicate name was accepted");
+        commands[1].name = "";
+        asserteq(cla_compileDispatcher(&dispatcher), cla_illegalInputError, "empty name was accepted");
+        commands[1].name = "test";
+        asserteq(cla_compileDispatcher(&dispatcher), cla_noErrors);
+    }
+
+    it("parses global options, then options of selected command") {
+        char
+            *argv[] = {"binary", "--verbose", "build", "--jobs=4", "target"},
+            *globalArguments[1],
+            *buildArguments[1];
+        uint64_t
+            globalReferences[cla_numberOfWords(1)],
+            buildReferences[cla_numberOfWords(1)];
+        bool
+            isVerbose = false;
+        size_t
+            jobs = 0;
+        cla_option_t
+            globalOptions[] = {{
+                    .name = "verbose",
+                    .handler = &cla_booleanHandler,
+                    .valuePtr = &isVerbose,
+                },
+            },
+            buildOptions[] = {{
+                    .name = "jobs",
+                    .handler = &cla_integerHandler,
+                    .valuePtr = &jobs,
+                },
+            },
+            testOptions[] = {{
+                    .name = "filter",
+                },
+            };
+        cla_slot_t
+            globalSlots[cla_numberOfSlots(1)],
+            buildSlots[cla_numberOfSlots(1)],
+            testSlots[cla_numberOfSlots(1)],
+            commandSlots[cla_numberOfSlots(2)];
+        cla_schema_t
+            globals = {
+                .options = globalOptions,
+                .numberOfOptions = 1,
+                .slots = globalSlots,
+                .numberOfSlots = sizeof globalSlots / sizeof *globalSlots,
+            },
+            build = {
+                .options = buildOptions,
+                .numberOfOptions = 1,
+                .slots = buildSlots,
+                .numberOfSlots = sizeof buildSlots / sizeof *buildSlots,
+            },
+            test = {
+                .options = testOptions,
+                .numberOfOptions = 1,
+                .slots = testSlots,
+                .numberOfSlots = sizeof testSlots / sizeof *testSlots,
+            };
+        cla_command_t
+            commands[] = {{
+                    .name = "build",
+                    .schema = &build,
+                }, {
+                    .name = "test",
+                    .schema = &test,
+                },
+            },
+            *command;
+        cla_dispatcher_t
+            dispatcher = {
+                .globals = &globals,
+                .commands = commands,
+                .numberOfCommands = sizeof commands / sizeof *commands,
+                .slots = commandSlots,
+                .numberOfSlots = sizeof commandSlots / sizeof *commandSlots,
+            };
+        cla_result_t
+            globalResult = {
+                .arguments = globalArguments,
+                .references = globalReferences,
+            },
+            commandResult = {
+                .arguments = buildArguments,
+                .references = buildReferences,
+            };
+
+        asserteq(cla_compileSchema(&globals), cla_noErrors);
+        asserteq(cla_compileDispatcher(&dispatcher), cla_noErrors);
+        assert(!commands[0].isCompiled && !commands[1].isCompiled, "command schema was compiled in advance");
+        asserteq(cla_dispatch(&dispatcher, &globalResult, &commandResult, 5, argv, &command), cla_noErrors);
+        asserteq_ptr(command, &commands[0]);
+        assert(commands[0].isCompiled, "selected command was not compiled");
+        assert(!commands[1].isCompiled, "unselected command was compiled");
+        assert(isVerbose, "global option was not parsed");
+        asserteq(jobs, 4);
+        asserteq_ptr(commandResult.next, argv[4]);
+    }
+
+    it("reports missing and unknown commands") {
+        char
+            *missing[] = {"binary"},
+            *unknown[] = {"binary", "deploy"},
+            *help[] = {"binary", "--help", "deploy"},
+            *globalArguments[1];
+        uint64_t
+            globalReferences[cla_numberOfWords(1)];
+        cla_option_t
+            globalOptions[] = {{
+                    .name = "help",
+                    .isTerminal = true,
+                },
+            };
+        cla_slot_t
+            globalSlots[cla_numberOfSlots(1)],
+            commandSlots[cla_numberOfSlots(1)];
+        cla_schema_t
+            globals = {
+                .options = globalOptions,
+                .numberOfOptions = 1,
+                .slots = globalSlots,
+                .numberOfSlots = sizeof globalSlots / sizeof *globalSlots,
+            },
+            build = {
+                .numberOfOptions = 0,
+            };
+        cla_command_t
+            commands[] = {{
+                    .name = "build",
+                    .schema = &build,
+                },
+            },
+            *command = commands;
+        cla_dispatcher_t
+            dispatcher = {
+                .globals = &globals,
+                .commands = commands,
+                .numberOfCommands = 1,
+                .slots = commandSlots,
+                .numberOfSlots = sizeof commandSlots / sizeof *commandSlots,
+            };
+        cla_result_t
+            globalResult = {
+                .arguments = globalArguments,
+                .references = globalReferences,
+            },
+            commandResult = {
+                .numberOfRequiredReferences = 0,
+            };
+
+        asserteq(cla_compileSchema(&globals), cla_noErrors);
+        asserteq(cla_compileDispatcher(&dispatcher), cla_noErrors);
+        asserteq(cla_dispatch(&dispatcher, &globalResult, &commandResult, 1, missing, &command), cla_missingOptionError);
+        asserteq_ptr(command, NULL);
+        asserteq(cla_dispatch(&dispatcher, &globalResult, &commandResult, 2, unknown, &command), cla_unknowOptionError);
+        asserteq_ptr(command, NULL);
+        asserteq(cla_dispatch(&dispatcher, &globalResult, &commandResult, 3, help, &command), cla_noErrors, "terminal global option did not complete dispatch");
+        asserteq_ptr(command, NULL);
+        assert(globalResult.isTerminated);
+    }
+}
@@ -0,0 +1,182 @@
+#include <clarum/clarum.h>
+#include <snow/snow.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+static void
+writeConfigurationFile(
+    char *path,
+    char const *contents
+) {
+    int
+        descriptor;
+
+    strcpy(path, "/tmp/clarum-configuration-XXXXXX");
+    descriptor = mkstemp(path);
+
+    if (descriptor >= 0) {
+        ssize_t const
+            written = write(descriptor, contents, strlen(contents));
+
+        (void) written;
+        close(descriptor);
+    }
+}
+
+describe(configuration) {
+    it("merges command line, environment, and file by precedence") {
+        char
+            path[64],
+            *argv[] = {"binary", "--jobs=2"},
+            *environment[] = {"TOOL_LEVEL=5", NULL},
+            *arguments[5],
+            *name = NULL;
+        char const
+            contents[] =
+                "# comment\n"
+                "; another comment\n"
+                "\n"
+                "[build]\n"
+                "  jobs = 8\r\n"
+                "level=9\n"
+                "Name = ' spaced value '\n"
+                "verbose\n"
+                "depth = 3\n"
+                "depth = 4";
+        uint64_t
+            references[cla_numberOfWords(5)];
+        unsigned char
+            sources[5];
+        size_t
+            jobs = 0,
+            level = 0,
+            depth = 0;
+        bool
+            isVerbose = false;
+        cla_mapping_t
+            mappings[1];
+        cla_option_t
+            options[] = {{
+                    .name = "jobs",
+                    .handler = &cla_integerHandler,
+                    .valuePtr = &jobs,
+                }, {
+                    .name = "level",
+                    .handler = &cla_integerHandler,
+                    .valuePtr = &level,
+                    .environmentName = "TOOL_LEVEL",
+                }, {
+                    .name = "name",
+                    .synonym = "Name",
+                    .handler = &cla_stringHandler,
+                    .valuePtr = &name,
+                }, {
+                    .name = "verbose",
+                    .handler = &cla_booleanHandler,
+                    .valuePtr = &isVerbose,
+                }, {
+                    .name = "depth",
+                    .handler = &cla_integerHandler,
+                    .valuePtr = &depth,
+                    .isRequired = true,
+                },
+            };
+        cla_slot_t
+            slots[cla_numberOfSlots(5)];
+        cla_schema_t
+            schema = {
+                .options = options,
+                .numberOfOptions = sizeof options / sizeof *options,
+                .slots = slots,
+                .numberOfSlots = sizeof slots / sizeof *slots,
+            };
+        cla_result_t
+            result = {
+                .arguments = arguments,
+                .references = references,
+                .mappings = mappings,
+                .maximumNumberOfMappings = sizeof mappings / sizeof *mappings,
+                .environment = environment,
+                .configurationPath = path,
+                .sources = sources,
+            };
+
+        writeConfigurationFile(path, contents);
+
+        asserteq(cla_compileSchema(&schema), cla_noErrors);
+        asserteq(cla_parse(&schema, &result, 2, argv), cla_noErrors);
+        asserteq(jobs, 2, "file overrode command line");
+        asserteq(level, 5, "file overrode environment");
+        asserteq_str(name, " spaced value ");
+        assert(isVerbose, "flag key was not referenced");
+        asserteq(depth, 3, "repeated key overrode first setting");
+        asserteq(sources[0], cla_argumentSource);
+        asserteq(sources[1], cla_environmentSource);
+        asserteq(sources[2], cla_fileSource);
+        asserteq(sources[4], cla_fileSource);
+        asserteq(result.numberOfMappings, 1);
+        assert(result.arguments[2] >= mappings[0].address && result.arguments[2] < mappings[0].address + mappings[0].size,
+            "value was copied out of mapping");
+
+        cla_releaseResult(&result);
+        unlink(path);
+    }
+
+    it("reports unknown keys, malformed lines, and missing files") {
+        char
+            path[64],
+            *argv[] = {"binary"},
+            *arguments[1];
+        uint64_t
+            references[cla_numberOfWords(1)];
+        cla_mapping_t
+            mappings[1];
+        cla_option_t
+            options[] = {{
+                    .name = "jobs",
+                },
+            };
+        cla_slot_t
+            slots[cla_numberOfSlots(1)];
+        cla_schema_t
+            schema = {
+                .options = options,
+                .numberOfOptions = sizeof options / sizeof *options,
+                .slots = slots,
+                .numberOfSlots = sizeof slots / sizeof *slots,
+            };
+        cla_result_t
+            result = {
+                .arguments = arguments,
+                .references = references,
+                .configurationPath = path,
+            };
+
+        asserteq(cla_compileSchema(&schema), cla_noErrors);
+
+        writeConfigurationFile(path, "jobs = 1\nthreads = 2\n");
+        asserteq(cla_parse(&schema, &result, 1, argv), cla_outOfMemoryError, "file was mapped without storage");
+
+        result.mappings = mappings;
+        result.maximumNumberOfMappings = sizeof mappings / sizeof *mappings;
+        asserteq(cla_parse(&schema, &result, 1, argv), cla_unknowOptionError);
+
+        schema.isLenient = true;
+        asserteq(cla_parse(&schema, &result, 1, argv), cla_noErrors, "lenient schema rejected unknown key");
+        assert(cla_isReferenced(&result, 0));
+        unlink(path);
+
+        writeConfigurationFile(path, "[section\njobs = 1\n");
+        asserteq(cla_parse(&schema, &result, 1, argv), cla_illegalInputError, "unterminated section was accepted");
+        unlink(path);
+
+        writeConfigurationFile(path, " = 1\n");
+        asserteq(cla_parse(&schema, &result, 1, argv), cla_illegalInputError, "setting without key was accepted");
+        unlink(path);
+
+        asserteq(cla_parse(&schema, &result, 1, argv), cla_fileError);
+        cla_releaseResult(&result);
+    }
+}
@@ -0,0 +1,210 @@
+#include <clarum/clarum.hpp>
+#include <cstdio>
+#include <cstring>
+
+/*
+ * Checks header-only C++ front end against C engine.
+ * Snow is C only, hence these tests run as separate executable.
+ */
+
+namespace {
+
+struct settings_t {
+    std::size_t jobs;
+    bool isVerbose;
+    std::string_view name;
+    double ratio;
+    int delta;
+};
+
+constexpr auto
+    schema = clarum::makeSchema(
+        clarum::option<&settings_t::jobs>("jobs", 'j').withSynonym("parallel"),
+        clarum::option<&settings_t::isVerbose>("verbose", 'v'),
+        clarum::option<&settings_t::name>("name", 'n').required(),
+        clarum::option<&settings_t::ratio>("ratio", 'r'),
+        clarum::option<&settings_t::delta>("delta"),
+        clarum::option<nullptr>("help", 'h').terminal());
+
+/* Lookups are resolved at compile time. */
+static_assert(schema.findName("jobs") == 0);
+static_assert(schema.findName("parallel") == 0);
+static_assert(schema.findName("help") == 5);
+static_assert(schema.findName("hel") == -1);
+static_assert(schema.findName("helpx") == -1);
+static_assert(schema.findTag('r') == 3);
+static_assert(schema.findTag('x') == -1);
+static_assert(schema.indexOf<&settings_t::name>() == 2);
+static_assert(clarum::makeSchema().findName("jobs") == -1);
+
+std::size_t
+    numberOfChecks,
+    numberOfFailures;
+
+void
+check(
+    bool condition,
+    char const *message,
+    int line
+) {
+    ++numberOfChecks;
+
+    if (!condition) {
+        ++numberOfFailures;
+        std::fprintf(stderr, "cpp_tests.cpp:%d: %s\n", line, message);
+    }
+}
+
+#define check(condition, message) \
+    check((condition), (message), __LINE__)
+
+std::uint64_t
+    state = 88172645463325252u;
+
+std::uint64_t
+getRandomNumber(
+) {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return state;
+}
+
+void
+parsesTypedMembers(
+) {
+    char
+        binary[] = "binary",
+        jobs[] = "--parallel=12",
+        verbose[] = "-v",
+        name[] = "--name=foo",
+        ratio[] = "-r=2.5",
+        delta[] = "--delta=-4",
+        operand[] = "operand",
+        *argv[] = {binary, jobs, verbose, name, ratio, delta, operand};
+    settings_t
+        settings{};
+    auto const
+        result = schema.parse(settings, sizeof argv / sizeof *argv, argv);
+
+    check(result.status == cla_noErrors, "valid arguments were rejected");
+    check(settings.jobs == 12, "integer member was not decoded");
+    check(settings.isVerbose, "boolean member was not decoded");
+    check(settings.name == "foo", "string member was not set");
+    check(settings.ratio == 2.5, "floating member was not decoded");
+    check(settings.delta == -4, "signed member was not decoded");
+    check(result.next == operand, "first unprocessed argument was not recorded");
+    check(result.isReferenced(schema.indexOf<&settings_t::jobs>()), "reference was not recorded");
+    check(!result.isReferenced(schema.indexOf<nullptr>()), "reference was recorded");
+}
+
+/* Runs random argument vectors through both front ends. */
+void
+behavesAsEngine(
+) {
+    static char
+        vocabulary[][24] = {
+            "--jobs=4", "--jobs=x", "--jobs=", "--parallel=7", "-j=3", "-j", "--verbose=off", "-v",
+            "-vj=2", "--name=foo", "-n", "--name=a=b", "--ratio=2.5", "--ratio=1e400", "--ratio=x",
+            "--delta=-4", "--delta=99999999999", "--help", "-h", "-hv", "--unknown", "-x", "operand",
+            "--", "--=1", "-", "/j", "-=", "", "--Jobs", "//help", "-j-v",
+        };
+    std::size_t
+        jobs;
+    bool
+        isVerbose;
+    char
+        *name;
+    double
+        ratio;
+    std::int32_t
+        delta;
+    cla_option_t
+        options[] = {
+            {'j', "jobs", "parallel", &cla_integerHandler, &jobs, nullptr, false, false, false, 0, nullptr, nullptr, 0, false},
+            {'v', "verbose", nullptr, &cla_booleanHandler, &isVerbose, nullptr, false, false, false, 0, nullptr, nullptr, 0, false},
+            {'n', "name", nullptr, &cla_stringHandler, &name, nullptr, false, true, false, 0, nullptr, nullptr, 0, false},
+            {'r', "ratio", nullptr, &cla_doubleHandler, &ratio, nullptr, false, false, false, 0, nullptr, nullptr, 0, false},
+            {'\0', "delta", nullptr, &cla_int32Handler, &delta, nullptr, false, false, false, 0, nullptr, nullptr, 0, false},
+            {'h', "help", nullptr, nullptr, nullptr, nullptr, true, false, false, 0, nullptr, nullptr, 0, false},
+        };
+    cla_slot_t
+        slots[cla_numberOfSlots(6)];
+    cla_schema_t
+        engineSchema{};
+    char
+        *arguments[6];
+    std::uint64_t
+        references[cla_numberOfWords(6)];
+    cla_result_t
+        result{};
+    auto const
+        lenientSchema = schema.lenient();
+
+    engineSchema.options = options;
+    engineSchema.numberOfOptions = 6;
+    engineSchema.slots = slots;
+    engineSchema.numberOfSlots = cla_numberOfSlots(6);
+    result.arguments = arguments;
+    result.references = references;
+
+    check(cla_compileSchema(&engineSchema) == cla_noErrors, "engine schema was not compiled");
+
+    for (std::size_t i = 0; i < 20000; ++i) {
+        char
+            binary[] = "binary",
+            *argv[8] = {binary};
+        int const
+            argc = 1 + static_cast<int>(getRandomNumber() % 7);
+        bool const
+            isLenient = getRandomNumber() % 2;
+        settings_t
+            settings{};
+        int
+            status;
+
+        for (int j = 1; j < argc; ++j)
+            argv[j] = vocabulary[getRandomNumber() % (sizeof vocabulary / sizeof *vocabulary)];
+
+        jobs = 0;
+        isVerbose = false;
+        name = nullptr;
+        ratio = 0;
+        delta = 0;
+        engineSchema.isLenient = isLenient;
+
+        status = cla_parse(&engineSchema, &result, argc, argv);
+
+        auto const
+            outcome = isLenient
+                ? lenientSchema.parse(settings, argc, argv)
+                : schema.parse(settings, argc, argv);
+
+        check(outcome.status == status, "statuses differ");
+        check(outcome.next == result.next, "next arguments differ");
+        check(outcome.isTerminated == result.isTerminated, "termination differs");
+        check(settings.jobs == jobs, "integer values differ");
+        check(settings.isVerbose == isVerbose, "boolean values differ");
+        check(name ? settings.name == name : settings.name.empty(), "string values differ");
+        check(settings.ratio == ratio, "floating values differ");
+        check(settings.delta == delta, "signed values differ");
+
+        for (std::size_t j = 0; j < 6; ++j)
+            check(outcome.isReferenced(j) == cla_isReferenced(&result, j), "references differ");
+
+        if (numberOfFailures)
+            break;
+    }
+}
+
+} // namespace
+
+int
+main(
+) {
+    parsesTypedMembers();
+    behavesAsEngine();
+
+    std::printf("%zu/%zu passed\n", numberOfChecks - numberOfFailures, numberOfChecks);
+    return numberOfFailures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
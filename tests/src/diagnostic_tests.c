@@ -0,0 +1,395 @@
+#include <clarum/clarum.h>
+#include <snow/snow.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+static void
+writeFile(
+    char *path,
+    char const *contents
+) {
+    int
+        descriptor;
+
+    strcpy(path, "/tmp/clarum-diagnostic-XXXXXX");
+    descriptor = mkstemp(path);
+
+    if (descriptor >= 0) {
+        ssize_t const
+            written = write(descriptor, contents, strlen(contents));
+
+        (void) written;
+        close(descriptor);
+    }
+}
+
+/* Computes edit distance by textbook dynamic programming. */
+static size_t
+getDistance(
+    char const *left,
+    char const *right
+) {
+    size_t const
+        leftLength = strlen(left),
+        rightLength = strlen(right);
+    size_t
+        row[80];
+
+    for (size_t j = 0; j <= rightLength; ++j)
+        row[j] = j;
+
+    for (size_t i = 1; i <= leftLength; ++i) {
+        size_t
+            diagonal = row[0];
+
+        row[0] = i;
+
+        for (size_t j = 1; j <= rightLength; ++j) {
+            size_t const
+                above = row[j];
+            size_t
+                best = diagonal + (left[i - 1] != right[j - 1]);
+
+            if (above + 1 < best)
+                best = above + 1;
+
+            if (row[j - 1] + 1 < best)
+                best = row[j - 1] + 1;
+
+            diagonal = above;
+            row[j] = best;
+        }
+    }
+
+    return row[rightLength];
+}
+
+describe(diagnostic) {
+    it("locates unknown options and suggests closest names") {
+        char
+            *argv[] = {"binary", "--jobs=2", "--versbose"},
+            *tagged[] = {"binary", "-qz"},
+            *arguments[5];
+        char const
+            buffer[] = "binary\0--jobs=1\0--outptu=file";
+        uint64_t
+            references[cla_numberOfWords(5)];
+        cla_diagnostic_t
+            diagnostic;
+        cla_option_t
+            options[] = {{
+                    .name = "verbose",
+                    .tag = 'v',
+                }, {
+                    .name = "version",
+                }, {
+                    .name = "jobs",
+                    .tag = 'j',
+                }, {
+                    .name = "output",
+                    .synonym = "out",
+                }, {
+                    .name = "quiet",
+                    .tag = 'q',
+                },
+            };
+        cla_slot_t
+            slots[cla_numberOfSlots(5)];
+        cla_schema_t
+            schema = {
+                .options = options,
+                .numberOfOptions = sizeof options / sizeof *options,
+                .slots = slots,
+                .numberOfSlots = sizeof slots / sizeof *slots,
+            };
+        cla_result_t
+            result = {
+                .arguments = arguments,
+                .references = references,
+                .diagnostic = &diagnostic,
+            };
+
+        asserteq(cla_compileSchema(&schema), cla_noErrors);
+
+        asserteq(cla_parse(&schema, &result, 3, argv), cla_unknowOptionError);
+        asserteq(diagnostic.source, cla_argumentSource);
+        asserteq(diagnostic.index, 2);
+        asserteq(diagnostic.offset, 2);
+        asserteq_ptr(diagnostic.token, &argv[2][2]);
+        asserteq(diagnostic.tokenLength, 8);
+        asserteq_ptr(diagnostic.option, NULL);
+        asserteq(diagnostic.numberOfSuggestions, 2, "closest names were not suggested");
+        asserteq_ptr(diagnostic.suggestions[0], &options[0]);
+        asserteq_ptr(diagnostic.suggestions[1], &options[1]);
+
+        asserteq(cla_parseBuffer(&schema, &result, buffer, sizeof buffer), cla_unknowOptionError);
+        asserteq(diagnostic.index, 2);
+        asserteq(diagnostic.tokenLength, 6);
+        asserteq(diagnostic.numberOfSuggestions, 1);
+        asserteq_ptr(diagnostic.suggestions[0], &options[3]);
+
+        asserteq(cla_parse(&schema, &result, 2, tagged), cla_unknowOptionError);
+        asserteq(diagnostic.index, 1);
+        asserteq(diagnostic.offset, 2);
+        asserteq(diagnostic.tokenLength, 1);
+        asserteq(diagnostic.numberOfSuggestions, 0, "tag was given suggestions");
+
+        asserteq(cla_parse(&schema, &result, 2, argv), cla_noErrors);
+        asserteq_ptr(diagnostic.token, NULL, "successful parse left diagnostic");
+        asserteq(diagnostic.index, 0);
+    }
+
+    it("reports rejected values, malformed arguments, and missing options") {
+        char
+            *argv[] = {"binary", "-qj=many"},
+            *malformed[] = {"binary", "--jobs=1", "---x"},
+            *missing[] = {"binary", "--jobs=1"},
+            *arguments[3];
+        uint64_t
+            references[cla_numberOfWords(3)];
+        size_t
+            jobs = 0,
+            level = 0;
+        cla_diagnostic_t
+            diagnostic;
+        cla_option_t
+            options[] = {{
+                    .name = "quiet",
+                    .tag = 'q',
+                }, {
+                    .name = "jobs",
+                    .tag = 'j',
+                    .handler = &cla_integerHandler,
+                    .valuePtr = &jobs,
+                }, {
+                    .name = "level",
+                    .handler = &cla_integerHandler,
+                    .valuePtr = &level,
+                    .isRequired = true,
+                },
+            };
+        cla_slot_t
+            slots[cla_numberOfSlots(3)];
+        cla_schema_t
+            schema = {
+                .options = options,
+                .numberOfOptions = sizeof options / sizeof *options,
+                .slots = slots,
+                .numberOfSlots = sizeof slots / sizeof *slots,
+            };
+        cla_result_t
+            result = {
+                .arguments = arguments,
+                .references = references,
+                .diagnostic = &diagnostic,
+            };
+
+        asserteq(cla_compileSchema(&schema), cla_noErrors);
+
+        assert(cla_parse(&schema, &result, 2, argv) != cla_noErrors);
+        asserteq(diagnostic.source, cla_argumentSource);
+        asserteq(diagnostic.index, 1);
+        asserteq(diagnostic.offset, 4, "value offset within bundle is wrong");
+        asserteq(diagnostic.tokenLength, 4);
+        asserteq_ptr(diagnostic.option, &options[1]);
+
+        asserteq(cla_parse(&schema, &result, 3, malformed), cla_illegalInputError);
+        asserteq(diagnostic.index, 2);
+        asserteq(diagnostic.offset, 0);
+        asserteq_ptr(diagnostic.token, malformed[2], "malformed argument was not reported whole");
+        asserteq(diagnostic.tokenLength, 4);
+
+        asserteq(cla_parse(&schema, &result, 2, missing), cla_missingOptionError);
+        asserteq(diagnostic.source, 0);
+        asserteq_ptr(diagnostic.token, NULL);
+        asserteq_ptr(diagnostic.option, &options[2], "missing option was not reported");
+    }
+
+    it("locates tokens in response files, environment, and configuration") {
+        char
+            responsePath[64],
+            configurationPath[64],
+            missingPath[] = "/nonexistent/clarum.conf",
+            response[] = "--jobs=1 --lvel=2",
+            *argv[] = {"binary", "-q", NULL},
+            *environment[] = {"HOME=/root", "TOOL_JOBS=many", NULL},
+            *arguments[3];
+        uint64_t
+            references[cla_numberOfWords(3)];
+        size_t
+            jobs = 0,
+            level = 0;
+        cla_mapping_t
+            mappings[2];
+        cla_diagnostic_t
+            diagnostic;
+        cla_option_t
+            options[] = {{
+                    .name = "quiet",
+                    .tag = 'q',
+                }, {
+                    .name = "jobs",
+                    .handler = &cla_integerHandler,
+                    .valuePtr = &jobs,
+                    .environmentName = "TOOL_JOBS",
+                }, {
+                    .name = "level",
+                    .handler = &cla_integerHandler,
+                    .valuePtr = &level,
+                },
+            };
+        cla_slot_t
+            slots[cla_numberOfSlots(3)];
+        cla_schema_t
+            schema = {
+                .options = options,
+                .numberOfOptions = sizeof options / sizeof *options,
+                .slots = slots,
+                .numberOfSlots = sizeof slots / sizeof *slots,
+            };
+        cla_result_t
+            result = {
+                .arguments = arguments,
+                .references = references,
+                .mappings = mappings,
+                .maximumNumberOfMappings = sizeof mappings / sizeof *mappings,
+                .diagnostic = &diagnostic,
+            };
+
+        writeFile(responsePath, response);
+        writeFile(configurationPath, "# comment\njobs = \"1\"\n\n  levle = 2\n");
+        asserteq(cla_compileSchema(&schema), cla_noErrors);
+
+        argv[2] = (char[70]) {"@"};
+        strcat(argv[2], responsePath);
+        asserteq(cla_parse(&schema, &result, 3, argv), cla_unknowOptionError);
+        asserteq(diagnostic.index, 2, "response file word was not reported at its argument");
+        asserteq(diagnostic.offset, 2);
+        asserteq(diagnostic.tokenLength, 4);
+        asserteq(strncmp(diagnostic.token, "lvel", 4), 0);
+        asserteq(diagnostic.numberOfSuggestions, 1);
+        asserteq_ptr(diagnostic.suggestions[0], &options[2]);
+        cla_releaseResult(&result);
+
+        result.environment = environment;
+        asserteq(cla_parse(&schema, &result, 2, argv), cla_illegalInputError);
+        asserteq(diagnostic.source, cla_environmentSource);
+        asserteq(diagnostic.index, 2);
+        asserteq(diagnostic.offset, 10);
+        asserteq_ptr(diagnostic.option, &options[1]);
+        result.environment = NULL;
+
+        result.configurationPath = configurationPath;
+        asserteq(cla_parse(&schema, &result, 2, argv), cla_unknowOptionError);
+        asserteq(diagnostic.source, cla_fileSource);
+        asserteq(diagnostic.index, 4, "line number is wrong");
+        asserteq(diagnostic.offset, 2);
+        asserteq(strncmp(diagnostic.token, "levle", diagnostic.tokenLength), 0);
+        asserteq_ptr(diagnostic.suggestions[0], &options[2]);
+        cla_releaseResult(&result);
+
+        result.configurationPath = missingPath;
+        asserteq(cla_parse(&schema, &result, 2, argv), cla_fileError);
+        asserteq_ptr(diagnostic.token, missingPath);
+
+        unlink(responsePath);
+        unlink(configurationPath);
+    }
+
+    it("suggests same options as exhaustive edit distance") {
+        enum {
+            numberOfOptions = 64,
+        };
+        char
+            names[numberOfOptions][16],
+            token[24],
+            *argv[] = {"binary", NULL},
+            *arguments[numberOfOptions];
+        uint64_t
+            references[cla_numberOfWords(numberOfOptions)];
+        cla_diagnostic_t
+            diagnostic;
+        cla_option_t
+            options[numberOfOptions];
+        cla_slot_t
+            slots[cla_numberOfSlots(numberOfOptions)];
+        cla_schema_t
+            schema = {
+                .options = options,
+                .numberOfOptions = numberOfOptions,
+                .slots = slots,
+                .numberOfSlots = sizeof slots / sizeof *slots,
+            };
+        cla_result_t
+            result = {
+                .arguments = arguments,
+                .references = references,
+                .diagnostic = &diagnostic,
+            };
+
+        srand(25);
+        memset(options, 0, sizeof options);
+
+        for (size_t i = 0; i < numberOfOptions; ++i) {
+            size_t const
+                length = 2 + (size_t) rand() % 10;
+
+            /* Small alphabet keeps names close to each other, index keeps them unique. */
+            for (size_t j = 0; j < length; ++j)
+                names[i][j] = "abc"[rand() % 3];
+
+            sprintf(&names[i][length], "%c", (char) ('A' + i % 26));
+            options[i].name = names[i];
+        }
+
+        asserteq(cla_compileSchema(&schema), cla_noErrors);
+
+        for (int round = 0; round < 2000; ++round) {
+            size_t const
+                length = 1 + (size_t) rand() % 14,
+                bound = length / 4 + 1 < 3 ? length / 4 + 1 : 3;
+            size_t
+                distances[cla_maximumNumberOfSuggestions],
+                numberOfExpected = 0;
+
+            token[0] = token[1] = '-';
+            for (size_t j = 0; j < length; ++j)
+                token[2 + j] = "abcA"[rand() % 4];
+
+            token[2 + length] = '\0';
+            argv[1] = token;
+
+            if (cla_parse(&schema, &result, 2, argv) == cla_noErrors)
+                /* Token names an option. */
+                continue;
+
+            for (size_t i = 0; i < numberOfOptions; ++i) {
+                size_t
+                    distance = getDistance(&token[2], names[i]),
+                    k = numberOfExpected;
+
+                if (distance > bound || (k == cla_maximumNumberOfSuggestions && distances[k - 1] <= distance))
+                    continue;
+
+                if (k == cla_maximumNumberOfSuggestions)
+                    --k;
+                else
+                    ++numberOfExpected;
+
+                for (; k && distances[k - 1] > distance; --k)
+                    distances[k] = distances[k - 1];
+
+                distances[k] = distance;
+            }
+
+            asserteq(diagnostic.numberOfSuggestions, numberOfExpected, "suggestions differ from exhaustive search");
+
+            for (size_t i = 0; i < numberOfExpected; ++i) {
+                asserteq(getDistance(&token[2], diagnostic.suggestions[i]->name), distances[i],
+                    "suggestion is farther than expected");
+            }
+        }
+    }
+}
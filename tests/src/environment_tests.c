@@ -0,0 +1,144 @@
+#include <clarum/clarum.h>
+#include <snow/snow.h>
+
+describe(environment) {
+    it("rejects duplicate environment names") {
+        cla_option_t
+            options[] = {{
+                    .name = "jobs",
+                    .environmentName = "TOOL_JOBS",
+                }, {
+                    .name = "threads",
+                    .environmentName = "TOOL_JOBS",
+                },
+            };
+        cla_slot_t
+            slots[cla_numberOfSlots(2)];
+        cla_schema_t
+            schema = {
+                .options = options,
+                .numberOfOptions = sizeof options / sizeof *options,
+                .slots = slots,
+                .numberOfSlots = sizeof slots / sizeof *slots,
+            };
+
+        asserteq(cla_compileSchema(&schema), cla_illegalInputError, "duplicate environment name was accepted");
+        options[1].environmentName = "jobs";
+        asserteq(cla_compileSchema(&schema), cla_noErrors, "environment name clashed with option name");
+        asserteq(schema.numberOfEnvironmentOptions, 2);
+    }
+
+    it("falls back to environment for options not given on command line") {
+        char
+            *argv[] = {"binary", "--jobs=4"},
+            *environment[] = {"HOME=/root", "TOOL_JOBS=8", "MALFORMED", "TOOL_LEVEL=3", "jobs=16", "TOOL_NAME=", NULL},
+            *arguments[4];
+        uint64_t
+            references[cla_numberOfWords(4)];
+        unsigned char
+            sources[4];
+        size_t
+            jobs = 0,
+            level = 0,
+            depth = 0;
+        char const
+            *name = "unset";
+        cla_option_t
+            options[] = {{
+                    .name = "jobs",
+                    .handler = &cla_integerHandler,
+                    .valuePtr = &jobs,
+                    .environmentName = "TOOL_JOBS",
+                }, {
+                    .name = "level",
+                    .handler = &cla_integerHandler,
+                    .valuePtr = &level,
+                    .environmentName = "TOOL_LEVEL",
+                    .isRequired = true,
+                }, {
+                    .name = "depth",
+                    .handler = &cla_integerHandler,
+                    .valuePtr = &depth,
+                    .environmentName = "TOOL_DEPTH",
+                }, {
+                    .name = "name",
+                    .handler = &cla_stringHandler,
+                    .valuePtr = &name,
+                    .environmentName = "TOOL_NAME",
+                },
+            };
+        cla_slot_t
+            slots[cla_numberOfSlots(4)];
+        cla_schema_t
+            schema = {
+                .options = options,
+                .numberOfOptions = sizeof options / sizeof *options,
+                .slots = slots,
+                .numberOfSlots = sizeof slots / sizeof *slots,
+            };
+        cla_result_t
+            result = {
+                .arguments = arguments,
+                .references = references,
+                .environment = environment,
+                .sources = sources,
+            };
+
+        asserteq(cla_compileSchema(&schema), cla_noErrors);
+        asserteq(cla_parse(&schema, &result, 2, argv), cla_noErrors, "required option was not taken from environment");
+        asserteq(jobs, 4, "environment overrode command line");
+        asserteq(level, 3);
+        asserteq(depth, 0);
+        asserteq_str(name, "");
+        asserteq(sources[0], cla_argumentSource);
+        asserteq(sources[1], cla_environmentSource);
+        asserteq(sources[3], cla_environmentSource);
+        assert(!cla_isReferenced(&result, 2), "unset variable referenced option");
+        asserteq_ptr(result.arguments[1], &environment[3][11]);
+
+        result.environment = NULL;
+        asserteq(cla_parse(&schema, &result, 2, argv), cla_missingOptionError, "environment was consulted without being set");
+    }
+
+    it("reports handler errors and skips terminated parses") {
+        char
+            *argv[] = {"binary"},
+            *help[] = {"binary", "--help"},
+            *environment[] = {"TOOL_JOBS=many", NULL},
+            *arguments[2];
+        uint64_t
+            references[cla_numberOfWords(2)];
+        size_t
+            jobs = 0;
+        cla_option_t
+            options[] = {{
+                    .name = "jobs",
+                    .handler = &cla_integerHandler,
+                    .valuePtr = &jobs,
+                    .environmentName = "TOOL_JOBS",
+                }, {
+                    .name = "help",
+                    .isTerminal = true,
+                },
+            };
+        cla_slot_t
+            slots[cla_numberOfSlots(2)];
+        cla_schema_t
+            schema = {
+                .options = options,
+                .numberOfOptions = sizeof options / sizeof *options,
+                .slots = slots,
+                .numberOfSlots = sizeof slots / sizeof *slots,
+            };
+        cla_result_t
+            result = {
+                .arguments = arguments,
+                .references = references,
+                .environment = environment,
+            };
+
+        asserteq(cla_compileSchema(&schema), cla_noErrors);
+        asserteq(cla_parse(&schema, &result, 1, argv), cla_illegalInputError, "malformed environment value was accepted");
+        asserteq(cla_parse(&schema, &result, 2, help), cla_noErrors, "environment was consulted after terminal option");
+    }
+}
@@ -0,0 +1,157 @@
+#include <clarum/clarum.h>
+#include <generated.h>
+#include <snow/snow.h>
+#include <string.h>
+
+typedef struct {
+    size_t jobs;
+    size_t numberOfCalls;
+    bool isVerbose;
+    char *name;
+    char *title;
+    char *output;
+} values_t;
+
+/* Referenced by generated parser, hence not static. */
+int
+countingHandler(
+    cla_parser_t *parser,
+    cla_option_t *option
+) {
+    size_t
+        *numberOfCalls = option->valuePtr;
+
+    (void) parser;
+
+    ++*numberOfCalls;
+    return option->argument && !*option->argument
+        ? cla_illegalInputError
+        : cla_noErrors;
+}
+
+static void
+bindValues(
+    cla_option_t *options,
+    values_t *values
+) {
+    memset(values, 0, sizeof *values);
+    options[generated_jobs].valuePtr = &values->jobs;
+    options[generated_job].valuePtr = &values->numberOfCalls;
+    options[generated_verbose].valuePtr = &values->isVerbose;
+    options[generated_name].valuePtr = &values->name;
+    options[generated_shadowed].valuePtr = &values->title;
+    options[generated_output].valuePtr = &values->output;
+}
+
+static uint64_t
+    state = 88172645463325252u;
+
+static uint64_t
+getRandomNumber(
+    void
+) {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return state;
+}
+
+describe(generator) {
+    it("checks for null pointers and options") {
+        char
+            *argv[] = {"binary", "--jobs=1"};
+        cla_option_t
+            options[] = generated_options;
+        cla_parser_t
+            parser = {
+                .options = options,
+                .numberOfOptions = generated_numberOfOptions - 1,
+            };
+
+        asserteq(generated_numberOfOptions, 8, "option indices were not generated");
+        asserteq(generated_parseOptions(NULL, 2, argv), cla_nullReferenceError, "@parser was not checked for NULL");
+        asserteq(generated_parseOptions(&parser, 2, NULL), cla_nullReferenceError, "@argv was not checked for NULL");
+        asserteq(generated_parseOptions(&parser, 2, argv), cla_illegalInputError, "missing options were not reported");
+    }
+
+    it("behaves as interpreting parser") {
+        static char
+            vocabulary[][16] = {
+                "--jobs=4", "--jobs=x", "--j=7", "-j=3", "--job", "--job=", "--job=1", "-J", "-vJ=2",
+                "--verbose=off", "-v", "--name=foo", "--title=bar", "-n", "-n=x", "--java", "--jav",
+                "--javax", "--title", "-o=out", "--output-file=f", "--o", "--help", "-h", "-hv",
+                "--unknown", "-x", "operand", "--", "--=1", "-", "/j", "-=", "", "-vj", "--Jobs",
+                "-j-v", "//help", "--name=a=b",
+            };
+
+        for (size_t i = 0; i < 20000; ++i) {
+            char
+                *argv[8] = {"binary"};
+            int const
+                argc = 1 + (int) (getRandomNumber() % 7);
+            bool const
+                isLenient = getRandomNumber() % 2;
+            cla_option_t
+                interpretedOptions[] = generated_options,
+                generatedOptions[] = generated_options;
+            values_t
+                interpretedValues,
+                generatedValues;
+            cla_parser_t
+                interpreted = {
+                    .options = interpretedOptions,
+                    .numberOfOptions = generated_numberOfOptions,
+                    .isLenient = isLenient,
+                },
+                generated = {
+                    .options = generatedOptions,
+                    .numberOfOptions = generated_numberOfOptions,
+                    .isLenient = isLenient,
+                };
+            int
+                status;
+
+            for (int j = 1; j < argc; ++j)
+                argv[j] = vocabulary[getRandomNumber() % (sizeof vocabulary / sizeof *vocabulary)];
+
+            bindValues(interpretedOptions, &interpretedValues);
+            bindValues(generatedOptions, &generatedValues);
+
+            status = cla_parseOptions(&interpreted, argc, argv);
+            asserteq(generated_parseOptions(&generated, argc, argv), status, "statuses differ");
+            asserteq_ptr(generated.next, interpreted.next, "next arguments differ");
+            asserteq(generated.isTerminated, interpreted.isTerminated, "termination differs");
+            assert(!memcmp(&generatedValues, &interpretedValues, sizeof generatedValues), "values differ");
+
+            for (size_t j = 0; j < generated_numberOfOptions; ++j) {
+                asserteq(generatedOptions[j].isReferenced, interpretedOptions[j].isReferenced, "references differ");
+                asserteq_ptr(generatedOptions[j].argument, interpretedOptions[j].argument, "arguments differ");
+                asserteq(generatedOptions[j].argumentLength, interpretedOptions[j].argumentLength);
+            }
+        }
+    }
+
+    it("honours references made before parse") {
+        char
+            *argv[] = {"binary", "-v"},
+            *name = NULL;
+        cla_option_t
+            options[] = generated_options;
+        cla_parser_t
+            parser = {
+                .options = options,
+                .numberOfOptions = generated_numberOfOptions,
+            };
+        values_t
+            values;
+
+        bindValues(options, &values);
+        options[generated_name].isReferenced = true;
+        options[generated_name].valuePtr = &name;
+
+        asserteq(generated_parseOptions(&parser, 2, argv), cla_missingOptionError, "required option was not reported");
+        options[generated_output].isReferenced = true;
+        asserteq(generated_parseOptions(&parser, 2, argv), cla_noErrors, "preset reference was not honoured");
+        asserteq(values.isVerbose, true, "boolean option value was not decoded");
+    }
+}
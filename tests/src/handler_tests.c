@@ -0,0 +1,403 @@
+#include <clarum/clarum.h>
+#include <inttypes.h>
+#include <math.h>
+#include <snow/snow.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static int
+decode(
+    cla_handler_t *handler,
+    char *argument,
+    void *valuePtr
+) {
+    cla_option_t
+        option = {
+            .argument = argument,
+            .argumentLength = strlen(argument),
+            .valuePtr = valuePtr,
+        };
+
+    return handler(NULL, &option);
+}
+
+static uint64_t
+    state = 88172645463325252u;
+
+static uint64_t
+getRandomNumber(
+    void
+) {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return state;
+}
+
+static bool
+matchesStrtod(
+    char *argument
+) {
+    double
+        value,
+        expected = strtod(argument, NULL);
+    float
+        floatValue,
+        floatExpected = strtof(argument, NULL);
+    /* Overflow to infinity is rejected. */
+    bool const
+        isDoubleMatched = isinf(expected)
+            ? decode(&cla_doubleHandler, argument, &value) == cla_illegalInputError
+            : !decode(&cla_doubleHandler, argument, &value) && !memcmp(&value, &expected, sizeof value),
+        isFloatMatched = isinf(floatExpected)
+            ? decode(&cla_floatHandler, argument, &floatValue) == cla_illegalInputError
+            : !decode(&cla_floatHandler, argument, &floatValue) && !memcmp(&floatValue, &floatExpected, sizeof floatValue);
+
+    return isDoubleMatched && isFloatMatched;
+}
+
+describe(handler) {
+    it("checks for null pointers") {
+        size_t
+            value = 0;
+        cla_option_t
+            option = {
+                .argument = NULL,
+                .valuePtr = &value,
+            };
+
+        asserteq(cla_integerHandler(NULL, &option), cla_nullReferenceError, "argument was not checked for NULL");
+        asserteq(decode(&cla_integerHandler, "1", NULL), cla_nullReferenceError, "value was not checked for NULL");
+    }
+
+    it("resolves keywords of compiled choice") {
+        cla_keyword_t const
+            keywords[] = {
+                {"fast", 1}, {"balanced", 2}, {"small", 3}, {"f", 4}, {"fastest", 5},
+            };
+        cla_choice_t
+            choice = {
+                .keywords = keywords,
+                .numberOfKeywords = sizeof keywords / sizeof *keywords,
+            };
+        int
+            value = 0;
+        cla_option_t
+            option = {
+                .valuePtr = &value,
+                .context = &choice,
+            };
+
+        asserteq(cla_compileChoice(&choice), cla_noErrors);
+
+        for (size_t i = 0; i < sizeof keywords / sizeof *keywords; ++i) {
+            option.argument = (char *) keywords[i].name;
+            option.argumentLength = strlen(keywords[i].name);
+            asserteq(cla_choiceHandler(NULL, &option), cla_noErrors, "keyword was not resolved");
+            asserteq(value, keywords[i].value, "keyword value was not stored");
+        }
+
+        /* Only leading part of argument counts. */
+        option.argument = "smallest";
+        option.argumentLength = 5;
+        asserteq(cla_choiceHandler(NULL, &option), cla_noErrors, "argument was not bounded by length");
+        asserteq(value, 3);
+
+        option.argumentLength = 4;
+        asserteq(cla_choiceHandler(NULL, &option), cla_illegalInputError, "prefix of keyword was accepted");
+        option.argument = "fas";
+        option.argumentLength = 3;
+        asserteq(cla_choiceHandler(NULL, &option), cla_illegalInputError, "prefix of keyword was accepted");
+        option.argument = "";
+        option.argumentLength = 0;
+        asserteq(cla_choiceHandler(NULL, &option), cla_illegalInputError, "empty argument was accepted");
+        option.argument = NULL;
+        asserteq(cla_choiceHandler(NULL, &option), cla_nullReferenceError, "argument was not checked for NULL");
+    }
+
+    it("rejects malformed choices") {
+        cla_keyword_t const
+            duplicates[] = {
+                {"fast", 1}, {"slow", 2}, {"fast", 3},
+            },
+            unnamed[] = {
+                {"fast", 1}, {NULL, 2},
+            };
+        cla_keyword_t
+            many[cla_maximumNumberOfKeywords + 1];
+        char
+            names[cla_maximumNumberOfKeywords + 1][4];
+        cla_choice_t
+            choice = {
+                .keywords = duplicates,
+                .numberOfKeywords = sizeof duplicates / sizeof *duplicates,
+            };
+
+        asserteq(cla_compileChoice(NULL), cla_nullReferenceError, "@choice was not checked for NULL");
+        asserteq(cla_compileChoice(&choice), cla_illegalInputError, "duplicate keywords were accepted");
+
+        choice.keywords = unnamed;
+        choice.numberOfKeywords = sizeof unnamed / sizeof *unnamed;
+        asserteq(cla_compileChoice(&choice), cla_nullReferenceError, "keyword name was not checked for NULL");
+
+        for (size_t i = 0; i < sizeof many / sizeof *many; ++i) {
+            snprintf(names[i], sizeof names[i], "k%zu", i);
+            many[i] = (cla_keyword_t) {
+                .name = names[i],
+                .value = (int) i,
+            };
+        }
+
+        choice.keywords = many;
+        choice.numberOfKeywords = cla_maximumNumberOfKeywords;
+        asserteq(cla_compileChoice(&choice), cla_noErrors, "largest choice was not compiled");
+        choice.numberOfKeywords = cla_maximumNumberOfKeywords + 1;
+        asserteq(cla_compileChoice(&choice), cla_illegalInputError, "too many keywords were accepted");
+    }
+
+    it("decodes booleans") {
+        char
+            *truths[] = {"true", "yes", "on", "1"},
+            *falsities[] = {"false", "no", "off", "0"},
+            *invalid[] = {"", "tru", "truee", "On", "2", "of"};
+        bool
+            value;
+        cla_option_t
+            option = {
+                .valuePtr = &value,
+            };
+
+        asserteq(cla_booleanHandler(NULL, &option), cla_noErrors);
+        asserteq(value, true, "missing argument did not count as true");
+
+        for (size_t i = 0; i < 4; ++i) {
+            value = false;
+            asserteq(decode(&cla_booleanHandler, truths[i], &value), cla_noErrors);
+            asserteq(value, true, "true value was not decoded");
+            asserteq(decode(&cla_booleanHandler, falsities[i], &value), cla_noErrors);
+            asserteq(value, false, "false value was not decoded");
+        }
+
+        for (size_t i = 0; i < sizeof invalid / sizeof *invalid; ++i)
+            asserteq(decode(&cla_booleanHandler, invalid[i], &value), cla_illegalInputError, "invalid value was accepted");
+    }
+
+    it("decodes unsigned integers") {
+        uint64_t
+            value = 1;
+        uint32_t
+            narrowValue = 1;
+
+        asserteq(decode(&cla_uint64Handler, "0", &value), cla_noErrors, "zero was rejected");
+        asserteq(value, 0);
+        asserteq(decode(&cla_uint64Handler, "+0000000000000000000000042", &value), cla_noErrors, "leading zeros were rejected");
+        asserteq(value, 42);
+        asserteq(decode(&cla_uint64Handler, "1234567890123456", &value), cla_noErrors);
+        asserteq(value, 1234567890123456u, "eight-digit blocks were not decoded");
+        asserteq(decode(&cla_uint64Handler, "18446744073709551615", &value), cla_noErrors, "maximum value was rejected");
+        asserteq(value, UINT64_MAX);
+        asserteq(decode(&cla_uint32Handler, "4294967295", &narrowValue), cla_noErrors, "maximum value was rejected");
+        asserteq(narrowValue, UINT32_MAX);
+    }
+
+    it("rejects overflowing and malformed integers") {
+        uint64_t
+            value = 7;
+        uint32_t
+            narrowValue = 7;
+
+        asserteq(decode(&cla_uint64Handler, "18446744073709551616", &value), cla_illegalInputError, "overflow was accepted");
+        asserteq(decode(&cla_uint64Handler, "99999999999999999999", &value), cla_illegalInputError, "overflow was accepted");
+        asserteq(decode(&cla_uint64Handler, "100000000000000000000", &value), cla_illegalInputError, "overflow was accepted");
+        asserteq(decode(&cla_uint32Handler, "4294967296", &narrowValue), cla_illegalInputError, "overflow was accepted");
+        asserteq(decode(&cla_uint64Handler, "", &value), cla_illegalInputError, "empty argument was accepted");
+        asserteq(decode(&cla_uint64Handler, "+", &value), cla_illegalInputError, "sign only was accepted");
+        asserteq(decode(&cla_uint64Handler, "-1", &value), cla_illegalInputError, "negative value was accepted");
+        asserteq(decode(&cla_uint64Handler, "1234567a", &value), cla_illegalInputError, "non-digit was accepted");
+        asserteq(decode(&cla_uint64Handler, "12345678 ", &value), cla_illegalInputError, "trailing space was accepted");
+        asserteq(decode(&cla_uint64Handler, "12:45678", &value), cla_illegalInputError, "non-digit was accepted");
+        asserteq(value, 7, "value was modified on failure");
+        asserteq(narrowValue, 7, "value was modified on failure");
+    }
+
+    it("decodes signed integers") {
+        int32_t
+            narrowValue = 0;
+        int64_t
+            value = 0;
+
+        asserteq(decode(&cla_int32Handler, "-2147483648", &narrowValue), cla_noErrors, "minimum value was rejected");
+        asserteq(narrowValue, INT32_MIN);
+        asserteq(decode(&cla_int32Handler, "2147483647", &narrowValue), cla_noErrors, "maximum value was rejected");
+        asserteq(narrowValue, INT32_MAX);
+        asserteq(decode(&cla_int32Handler, "-2147483649", &narrowValue), cla_illegalInputError, "underflow was accepted");
+        asserteq(decode(&cla_int32Handler, "2147483648", &narrowValue), cla_illegalInputError, "overflow was accepted");
+        asserteq(decode(&cla_int64Handler, "-9223372036854775808", &value), cla_noErrors, "minimum value was rejected");
+        asserteq(value, INT64_MIN);
+        asserteq(decode(&cla_int64Handler, "-0", &value), cla_noErrors, "negative zero was rejected");
+        asserteq(value, 0);
+        asserteq(decode(&cla_int64Handler, "-9223372036854775809", &value), cla_illegalInputError, "underflow was accepted");
+        asserteq(decode(&cla_int64Handler, "9223372036854775808", &value), cla_illegalInputError, "overflow was accepted");
+    }
+
+    it("decodes hexadecimal integers") {
+        uint64_t
+            value = 0;
+        int32_t
+            signedValue = 0;
+
+        asserteq(decode(&cla_uint64Handler, "0xFFFFffffFFFFffff", &value), cla_noErrors, "maximum value was rejected");
+        asserteq(value, UINT64_MAX);
+        asserteq(decode(&cla_uint64Handler, "0X000000000000000010", &value), cla_noErrors, "leading zeros were rejected");
+        asserteq(value, 16);
+        asserteq(decode(&cla_int32Handler, "-0x80000000", &signedValue), cla_noErrors, "minimum value was rejected");
+        asserteq(signedValue, INT32_MIN);
+        asserteq(decode(&cla_uint64Handler, "0x10000000000000000", &value), cla_illegalInputError, "overflow was accepted");
+        asserteq(decode(&cla_uint64Handler, "0xg", &value), cla_illegalInputError, "non-digit was accepted");
+        asserteq(decode(&cla_uint64Handler, "0x", &value), cla_illegalInputError, "empty hexadecimal value was accepted");
+    }
+
+    it("decodes sizes") {
+        uint64_t
+            value = 0;
+
+        asserteq(decode(&cla_sizeHandler, "512", &value), cla_noErrors);
+        asserteq(value, 512);
+        asserteq(decode(&cla_sizeHandler, "512B", &value), cla_noErrors);
+        asserteq(value, 512);
+        asserteq(decode(&cla_sizeHandler, "64K", &value), cla_noErrors);
+        asserteq(value, 64 << 10);
+        asserteq(decode(&cla_sizeHandler, "64k", &value), cla_noErrors);
+        asserteq(value, 64 << 10);
+        asserteq(decode(&cla_sizeHandler, "4GiB", &value), cla_noErrors);
+        asserteq(value, 4ull << 30);
+        asserteq(decode(&cla_sizeHandler, "3MB", &value), cla_noErrors);
+        asserteq(value, 3000000);
+        asserteq(decode(&cla_sizeHandler, "15E", &value), cla_noErrors);
+        asserteq(value, 15ull << 60);
+        asserteq(decode(&cla_sizeHandler, "16E", &value), cla_illegalInputError, "overflow was accepted");
+        asserteq(decode(&cla_sizeHandler, "1Q", &value), cla_illegalInputError, "unknown suffix was accepted");
+        asserteq(decode(&cla_sizeHandler, "1KiBB", &value), cla_illegalInputError, "unknown suffix was accepted");
+        asserteq(decode(&cla_sizeHandler, "K", &value), cla_illegalInputError, "suffix only was accepted");
+    }
+
+    it("decodes durations") {
+        uint64_t
+            value = 0;
+
+        asserteq(decode(&cla_durationHandler, "250ms", &value), cla_noErrors);
+        asserteq(value, 250000000);
+        asserteq(decode(&cla_durationHandler, "3", &value), cla_noErrors);
+        asserteq(value, 3000000000u, "bare number was not taken as seconds");
+        asserteq(decode(&cla_durationHandler, "7ns", &value), cla_noErrors);
+        asserteq(value, 7);
+        asserteq(decode(&cla_durationHandler, "2min", &value), cla_noErrors);
+        asserteq(value, 120000000000u);
+        asserteq(decode(&cla_durationHandler, "1d", &value), cla_noErrors);
+        asserteq(value, 86400000000000u);
+        asserteq(decode(&cla_durationHandler, "1ks", &value), cla_illegalInputError, "unknown suffix was accepted");
+        asserteq(decode(&cla_durationHandler, "300000d", &value), cla_illegalInputError, "overflow was accepted");
+    }
+
+    it("rejects suffixes holding NUL") {
+        char
+            duration[] = "1s\0",
+            size[] = "1B\0";
+        uint64_t
+            value = 0;
+        cla_option_t
+            option = {
+                .argument = duration,
+                .argumentLength = sizeof duration - 1,
+                .valuePtr = &value,
+            };
+
+        asserteq(cla_durationHandler(NULL, &option), cla_illegalInputError, "NUL was matched as end of suffix");
+
+        option.argument = size;
+        option.argumentLength = sizeof size - 1;
+        asserteq(cla_sizeHandler(NULL, &option), cla_illegalInputError, "NUL was matched as end of suffix");
+    }
+
+    it("decodes floating-point values") {
+        double
+            value = 0;
+        float
+            floatValue = 0;
+
+        asserteq(decode(&cla_doubleHandler, "-0", &value), cla_noErrors);
+        asserteq(signbit(value) != 0, true, "sign of zero was lost");
+        asserteq(decode(&cla_doubleHandler, ".5e1", &value), cla_noErrors);
+        asserteq(value == 5, true);
+        asserteq(decode(&cla_doubleHandler, "+INF", &value), cla_noErrors, "infinity was rejected");
+        asserteq(isinf(value) != 0, true);
+        asserteq(decode(&cla_doubleHandler, "nan", &value), cla_noErrors, "NaN was rejected");
+        asserteq(isnan(value) != 0, true);
+        asserteq(decode(&cla_floatHandler, "0.1", &floatValue), cla_noErrors);
+        asserteq(floatValue == 0.1f, true, "float was rounded through double");
+        asserteq(decode(&cla_doubleHandler, "1e309", &value), cla_illegalInputError, "overflow was accepted");
+        asserteq(decode(&cla_floatHandler, "1e39", &floatValue), cla_illegalInputError, "overflow was accepted");
+        asserteq(decode(&cla_doubleHandler, "", &value), cla_illegalInputError, "empty argument was accepted");
+        asserteq(decode(&cla_doubleHandler, ".", &value), cla_illegalInputError, "point only was accepted");
+        asserteq(decode(&cla_doubleHandler, "1e", &value), cla_illegalInputError, "empty exponent was accepted");
+        asserteq(decode(&cla_doubleHandler, "1.2.3", &value), cla_illegalInputError, "trailing characters were accepted");
+        asserteq(decode(&cla_doubleHandler, "1,5", &value), cla_illegalInputError, "locale-specific point was accepted");
+        asserteq(decode(&cla_doubleHandler, "infinit", &value), cla_illegalInputError, "partial literal was accepted");
+    }
+
+    it("matches strtod bit for bit") {
+        static char const
+            *const corpus[] = {
+                "0", "1e-400", "4.9406564584124654e-324", "2.4703282292062327e-324", "2.4703282292062328e-324",
+                "2.2250738585072011e-308", "2.2250738585072014e-308", "1.7976931348623157e308",
+                "9007199254740993", "9007199254740993.0000000000000000000001", "1.00000005960464477539062499",
+                "1.000000059604644775390625", "3.4028235e38", "1.4e-45", "7e-46", "7.1e-46", "1e23",
+                "123456789012345678901234567890", "8.988465674311580536566680e307", "0.000000000000000000000001e24",
+            };
+        char
+            argument[1024];
+
+        for (size_t i = 0; i < sizeof corpus / sizeof *corpus; ++i) {
+            strcpy(argument, corpus[i]);
+            asserteq(matchesStrtod(argument), true, "edge case was not decoded exactly");
+        }
+
+        for (size_t i = 0; i < 20000; ++i) {
+            /* Positive value and its successor. */
+            uint64_t const
+                bits = getRandomNumber() >> 1,
+                nextBits = bits + 1;
+            double
+                value,
+                next;
+
+            memcpy(&value, &bits, sizeof value);
+            memcpy(&next, &nextBits, sizeof next);
+            if (!isfinite(next))
+                continue;
+
+            switch (i % 4) {
+            case 0:
+                /* Shortest round-trip representation. */
+                snprintf(argument, sizeof argument, "%.17g", value);
+                break;
+            case 1:
+                /* Random digits and exponent, often longer than 19 digits. */
+                snprintf(argument, sizeof argument, "%" PRIu64 ".%" PRIu64 "e%d", bits >> 20, getRandomNumber(),
+                    (int) (getRandomNumber() % 700) - 350);
+                break;
+            case 2:
+                /* Close to halfway point between neighbours. */
+                snprintf(argument, sizeof argument, "%.40Le", ((long double) value + next) / 2);
+                break;
+            default:
+                /* Exactly halfway point, written out in full. */
+                snprintf(argument, sizeof argument, "%.800Lg", ((long double) value + next) / 2);
+                break;
+            }
+
+            asserteq(matchesStrtod(argument), true, "random value was not decoded exactly");
+        }
+    }
+}
@@ -0,0 +1,270 @@
+#include <clarum/clarum.h>
+#include <fcntl.h>
+#include <generated.h>
+#include <image.h>
+#include <snow/snow.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+describe(image) {
+    it("checks for null pointers and misaligned images") {
+        uint64_t
+            image[256];
+        cla_option_t
+            options[] = {{
+                    .name = "jobs",
+                },
+            };
+        cla_slot_t
+            slots[cla_numberOfSlots(1)];
+        cla_schema_t
+            schema = {
+                .options = options,
+                .numberOfOptions = sizeof options / sizeof *options,
+                .slots = slots,
+                .numberOfSlots = sizeof slots / sizeof *slots,
+            };
+
+        asserteq(cla_compileSchema(&schema), cla_noErrors);
+        asserteq(cla_getSchemaImageSize(NULL), 0);
+        asserteq(cla_saveSchema(NULL, image, sizeof image), cla_nullReferenceError, "@schema was not checked for NULL");
+        asserteq(cla_saveSchema(&schema, NULL, sizeof image), cla_nullReferenceError, "@image was not checked for NULL");
+        asserteq(cla_saveSchema(&schema, (char *) image + 1, sizeof image - 1), cla_illegalInputError, "misaligned image was accepted");
+        asserteq(cla_saveSchema(&schema, image, cla_getSchemaImageSize(&schema) - 1), cla_outOfMemoryError, "small image was accepted");
+        asserteq(cla_loadSchema(NULL, image, sizeof image), cla_nullReferenceError, "@schema was not checked for NULL");
+        asserteq(cla_loadSchema(&schema, NULL, sizeof image), cla_nullReferenceError, "@image was not checked for NULL");
+    }
+
+    it("parses with loaded index as with compiled one") {
+        enum {
+            numberOfOptions = 3,
+        };
+        uint64_t
+            image[512],
+            references[cla_numberOfWords(numberOfOptions)];
+        char
+            *argv[] = {"binary", "-j=4", "--title=x", "-v"},
+            *arguments[numberOfOptions];
+        size_t
+            jobs = 0,
+            size;
+        char const
+            *name = NULL;
+        bool
+            isVerbose = false;
+        cla_option_t
+            options[] = {{
+                    .tag = 'j',
+                    .name = "jobs",
+                    .handler = &cla_integerHandler,
+                    .valuePtr = &jobs,
+                }, {
+                    .name = "name",
+                    .synonym = "title",
+                    .handler = &cla_stringHandler,
+                    .valuePtr = &name,
+                    .isRequired = true,
+                }, {
+                    .tag = 'v',
+                    .name = "verbose",
+                    .handler = &cla_booleanHandler,
+                    .valuePtr = &isVerbose,
+                    .environmentName = "TOOL_VERBOSE",
+                },
+            };
+        cla_slot_t
+            slots[cla_numberOfSlots(numberOfOptions)];
+        cla_schema_t
+            compiled = {
+                .options = options,
+                .numberOfOptions = numberOfOptions,
+                .slots = slots,
+                .numberOfSlots = sizeof slots / sizeof *slots,
+            },
+            loaded = {
+                .options = options,
+                .numberOfOptions = numberOfOptions,
+            };
+        cla_result_t
+            result = {
+                .arguments = arguments,
+                .references = references,
+            };
+
+        asserteq(cla_compileSchema(&compiled), cla_noErrors);
+        size = cla_getSchemaImageSize(&compiled);
+        asserteq(cla_saveSchema(&compiled, image, sizeof image), cla_noErrors);
+        asserteq(cla_loadSchema(&loaded, image, size), cla_noErrors);
+        asserteq_ptr(loaded.slots, (cla_slot_t *) ((char *) image + size) - compiled.numberOfSlots, "slots were copied out of image");
+        asserteq(loaded.numberOfRequiredOptions, 1);
+        asserteq(loaded.numberOfEnvironmentOptions, 1);
+        assert(!memcmp(loaded.tags, compiled.tags, sizeof loaded.tags), "tag table was not loaded");
+
+        asserteq(cla_parse(&loaded, &result, 4, argv), cla_noErrors);
+        asserteq(jobs, 4);
+        asserteq_str(name, "x");
+        assert(isVerbose);
+    }
+
+    it("rejects truncated, foreign, and stale images") {
+        uint64_t
+            image[512];
+        size_t
+            size;
+        cla_option_t
+            options[] = {{
+                    .name = "jobs",
+                }, {
+                    .name = "name",
+                },
+            },
+            renamed[] = {{
+                    .name = "jobs",
+                }, {
+                    .name = "names",
+                },
+            },
+            required[] = {{
+                    .name = "jobs",
+                }, {
+                    .name = "name",
+                    .isRequired = true,
+                },
+            };
+        cla_slot_t
+            slots[cla_numberOfSlots(2)];
+        cla_schema_t
+            schema = {
+                .options = options,
+                .numberOfOptions = 2,
+                .slots = slots,
+                .numberOfSlots = sizeof slots / sizeof *slots,
+            },
+            loaded = {
+                .options = options,
+                .numberOfOptions = 2,
+            };
+
+        asserteq(cla_compileSchema(&schema), cla_noErrors);
+        size = cla_getSchemaImageSize(&schema);
+        asserteq(cla_saveSchema(&schema, image, sizeof image), cla_noErrors);
+
+        asserteq(cla_loadSchema(&loaded, image, size - sizeof(cla_slot_t)), cla_illegalInputError, "truncated image was accepted");
+        asserteq(cla_loadSchema(&loaded, (char *) image + 4, size - 4), cla_illegalInputError, "misaligned image was accepted");
+
+        loaded.numberOfOptions = 1;
+        asserteq(cla_loadSchema(&loaded, image, size), cla_illegalInputError, "image of another shape was accepted");
+        loaded.numberOfOptions = 2;
+
+        loaded.options = renamed;
+        asserteq(cla_loadSchema(&loaded, image, size), cla_illegalInputError, "image of renamed options was accepted");
+        loaded.options = required;
+        asserteq(cla_loadSchema(&loaded, image, size), cla_illegalInputError, "image of changed options was accepted");
+        loaded.options = options;
+
+        ((uint32_t *) image)[1] += 1;
+        asserteq(cla_loadSchema(&loaded, image, size), cla_illegalInputError, "image of another version was accepted");
+        ((uint32_t *) image)[1] -= 1;
+        asserteq(cla_loadSchema(&loaded, image, size), cla_noErrors);
+    }
+
+    it("loads image from read-only file mapping") {
+        uint64_t
+            image[512],
+            references[cla_numberOfWords(1)];
+        char
+            path[] = "/tmp/clarum-image-XXXXXX",
+            *argv[] = {"binary", "--jobs=9"},
+            *arguments[1];
+        size_t
+            jobs = 0,
+            size;
+        int
+            descriptor;
+        void
+            *mapping;
+        cla_option_t
+            options[] = {{
+                    .name = "jobs",
+                    .handler = &cla_integerHandler,
+                    .valuePtr = &jobs,
+                },
+            };
+        cla_slot_t
+            slots[cla_numberOfSlots(1)];
+        cla_schema_t
+            schema = {
+                .options = options,
+                .numberOfOptions = 1,
+                .slots = slots,
+                .numberOfSlots = sizeof slots / sizeof *slots,
+            },
+            loaded = {
+                .options = options,
+                .numberOfOptions = 1,
+            };
+        cla_result_t
+            result = {
+                .arguments = arguments,
+                .references = references,
+            };
+
+        asserteq(cla_compileSchema(&schema), cla_noErrors);
+        size = cla_getSchemaImageSize(&schema);
+        asserteq(cla_saveSchema(&schema, image, sizeof image), cla_noErrors);
+
+        descriptor = mkstemp(path);
+        assert(descriptor >= 0);
+        asserteq((size_t) write(descriptor, image, size), size);
+
+        mapping = mmap(NULL, size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+        close(descriptor);
+        unlink(path);
+        assert(mapping != MAP_FAILED);
+
+        asserteq(cla_loadSchema(&loaded, mapping, size), cla_noErrors);
+        asserteq(cla_parse(&loaded, &result, 2, argv), cla_noErrors);
+        asserteq(jobs, 9);
+
+        munmap(mapping, size);
+    }
+
+    it("loads image emitted by generator") {
+        char
+            *argv[] = {"binary", "--title=x", "-v", "-j=2"},
+            *arguments[image_numberOfOptions];
+        uint64_t
+            references[cla_numberOfWords(image_numberOfOptions)];
+        size_t
+            jobs = 0;
+        char const
+            *name = NULL;
+        bool
+            isVerbose = false;
+        cla_option_t
+            options[] = image_options;
+        cla_schema_t
+            schema = {
+                .options = options,
+                .numberOfOptions = image_numberOfOptions,
+            };
+        cla_result_t
+            result = {
+                .arguments = arguments,
+                .references = references,
+            };
+
+        options[image_jobs].valuePtr = &jobs;
+        options[image_verbose].valuePtr = &isVerbose;
+        options[image_name].valuePtr = &name;
+
+        asserteq(generated_schemaImageSize, 0, "image of schema with shadowed keys was emitted");
+        asserteq(cla_loadSchema(&schema, image_schemaImage, image_schemaImageSize), cla_noErrors);
+        asserteq(cla_parse(&schema, &result, 4, argv), cla_noErrors);
+        asserteq_str(name, "x");
+        assert(isVerbose);
+        asserteq(jobs, 2);
+    }
+}
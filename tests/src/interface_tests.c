@@ -83,7 +83,8 @@ describe(interface) {
         char
             *argv[] = {"binary", "--sample=off", "--integer=100500"};
         int
-            argc = sizeof argv / sizeof *argv,
+            argc = sizeof argv / sizeof *argv;
+        size_t
             value = 0;
         cla_option_t
             options[] = {{
@@ -112,7 +113,8 @@ describe(interface) {
         char
             *argv[] = {"binary", "--sample=off", "--integer=100500"};
         int
-            argc = sizeof argv / sizeof *argv,
+            argc = sizeof argv / sizeof *argv;
+        size_t
             value = 0;
         cla_option_t
             options[] = {{
@@ -0,0 +1,275 @@
+#include <clarum/clarum.h>
+#include <snow/snow.h>
+#include <string.h>
+
+static size_t
+    numberOfCalls;
+
+static int
+countingHandler(
+    cla_parser_t *parser,
+    cla_option_t *option
+) {
+    ++numberOfCalls;
+    return cla_integerHandler(parser, option);
+}
+
+describe(lazy) {
+    it("checks for null pointers") {
+        char
+            *argv[] = {"binary", "--jobs=1"},
+            *arguments[1];
+        uint64_t
+            references[cla_numberOfWords(1)];
+        size_t
+            argumentLengths[1];
+        cla_option_t
+            options[] = {{
+                    .name = "jobs",
+                },
+            };
+        cla_slot_t
+            slots[cla_numberOfSlots(1)];
+        cla_schema_t
+            schema = {
+                .options = options,
+                .numberOfOptions = sizeof options / sizeof *options,
+                .slots = slots,
+                .numberOfSlots = sizeof slots / sizeof *slots,
+            };
+        cla_result_t
+            result = {
+                .arguments = arguments,
+                .references = references,
+                .argumentLengths = argumentLengths,
+            };
+
+        asserteq(cla_compileSchema(&schema), cla_noErrors);
+        asserteq(cla_get(&result, &options[0]), cla_nullReferenceError, "unparsed result was not rejected");
+        asserteq(cla_parse(&schema, &result, 2, argv), cla_nullReferenceError, "decoded bits were not checked for NULL");
+        asserteq(cla_get(NULL, &options[0]), cla_nullReferenceError, "@result was not checked for NULL");
+        asserteq(cla_get(&result, NULL), cla_nullReferenceError, "@option was not checked for NULL");
+    }
+
+    it("decodes values on first read only") {
+        char
+            *argv[] = {"binary", "--jobs=12", "--other=7", "-v"},
+            *arguments[4];
+        uint64_t
+            references[cla_numberOfWords(4)],
+            decodedOptions[cla_numberOfWords(4)];
+        size_t
+            argumentLengths[4],
+            jobs = 0,
+            other = 0,
+            unused = 0;
+        bool
+            isVerbose = false;
+        cla_option_t
+            options[] = {{
+                    .name = "jobs",
+                    .handler = &countingHandler,
+                    .valuePtr = &jobs,
+                }, {
+                    .name = "other",
+                    .handler = &countingHandler,
+                    .valuePtr = &other,
+                }, {
+                    .name = "unused",
+                    .handler = &countingHandler,
+                    .valuePtr = &unused,
+                }, {
+                    .tag = 'v',
+                    .handler = &cla_booleanHandler,
+                    .valuePtr = &isVerbose,
+                },
+            };
+        cla_slot_t
+            slots[cla_numberOfSlots(4)];
+        cla_schema_t
+            schema = {
+                .options = options,
+                .numberOfOptions = sizeof options / sizeof *options,
+                .slots = slots,
+                .numberOfSlots = sizeof slots / sizeof *slots,
+            };
+        cla_result_t
+            result = {
+                .arguments = arguments,
+                .references = references,
+                .argumentLengths = argumentLengths,
+                .decodedOptions = decodedOptions,
+            };
+
+        numberOfCalls = 0;
+
+        asserteq(cla_compileSchema(&schema), cla_noErrors);
+        asserteq(cla_parse(&schema, &result, sizeof argv / sizeof *argv, argv), cla_noErrors);
+        asserteq(numberOfCalls, 0, "handlers ran during lazy parse");
+        asserteq(isVerbose, false, "handlers ran during lazy parse");
+        asserteq(cla_isReferenced(&result, 0), true, "reference was not recorded");
+
+        asserteq(cla_get(&result, &options[0]), cla_noErrors);
+        asserteq(cla_get(&result, &options[0]), cla_noErrors);
+        asserteq(jobs, 12, "integer option value was not decoded");
+        asserteq(numberOfCalls, 1, "decoded value was not memoized");
+        asserteq(other, 0, "other option was decoded");
+
+        asserteq(cla_get(&result, &options[2]), cla_noErrors, "unreferenced option was not skipped");
+        asserteq(numberOfCalls, 1, "unreferenced option was decoded");
+        asserteq(cla_get(&result, &options[3]), cla_noErrors);
+        asserteq(isVerbose, true, "boolean option value was not decoded");
+
+        /* Next parse forgets decoded values. */
+        asserteq(cla_parse(&schema, &result, 2, argv), cla_noErrors);
+        asserteq(cla_get(&result, &options[0]), cla_noErrors);
+        asserteq(numberOfCalls, 2, "decoded bits were not reset");
+    }
+
+    it("checks references and required options up front") {
+        char
+            *argv[] = {"binary", "--jobs=x"},
+            *unknown[] = {"binary", "--unknown"},
+            *arguments[2];
+        uint64_t
+            references[cla_numberOfWords(2)],
+            decodedOptions[cla_numberOfWords(2)];
+        size_t
+            argumentLengths[2],
+            jobs = 3;
+        cla_option_t
+            options[] = {{
+                    .name = "jobs",
+                    .handler = &countingHandler,
+                    .valuePtr = &jobs,
+                }, {
+                    .name = "name",
+                    .isRequired = true,
+                },
+            },
+            foreign = {
+                .name = "jobs",
+            };
+        cla_slot_t
+            slots[cla_numberOfSlots(2)];
+        cla_schema_t
+            schema = {
+                .options = options,
+                .numberOfOptions = sizeof options / sizeof *options,
+                .slots = slots,
+                .numberOfSlots = sizeof slots / sizeof *slots,
+            };
+        cla_result_t
+            result = {
+                .arguments = arguments,
+                .references = references,
+                .argumentLengths = argumentLengths,
+                .decodedOptions = decodedOptions,
+            };
+
+        numberOfCalls = 0;
+
+        asserteq(cla_compileSchema(&schema), cla_noErrors);
+        asserteq(cla_parse(&schema, &result, 2, unknown), cla_unknowOptionError, "unknown option was not reported");
+        asserteq(cla_parse(&schema, &result, 2, argv), cla_missingOptionError, "missing option was not reported");
+        asserteq(cla_get(&result, &foreign), cla_illegalInputError, "foreign option was not rejected");
+        asserteq(cla_get(&result, &options[0]), cla_illegalInputError, "invalid argument was not reported");
+        asserteq(cla_get(&result, &options[0]), cla_illegalInputError, "failure was memoized");
+        asserteq(numberOfCalls, 2, "failure was memoized");
+        asserteq(jobs, 3, "value was written on failure");
+    }
+
+    it("bounds arguments of unterminated buffers") {
+        char
+            buffer[] = "binary\0--jobs=42XXXX",
+            *arguments[1];
+        _Alignas(16) char
+            storage[64];
+        uint64_t
+            references[cla_numberOfWords(1)],
+            decodedOptions[cla_numberOfWords(1)];
+        size_t
+            argumentLengths[1],
+            jobs = 0;
+        cla_option_t
+            options[] = {{
+                    .name = "jobs",
+                    .handler = &cla_integerHandler,
+                    .valuePtr = &jobs,
+                },
+            };
+        cla_slot_t
+            slots[cla_numberOfSlots(1)];
+        cla_schema_t
+            schema = {
+                .options = options,
+                .numberOfOptions = sizeof options / sizeof *options,
+                .slots = slots,
+                .numberOfSlots = sizeof slots / sizeof *slots,
+            };
+        cla_result_t
+            result = {
+                .arguments = arguments,
+                .references = references,
+                .argumentLengths = argumentLengths,
+                .decodedOptions = decodedOptions,
+                .arena = {
+                    .buffer = storage,
+                    .bufferSize = sizeof storage,
+                },
+            };
+        cla_stream_t
+            stream = {
+                .schema = &schema,
+                .result = &result,
+                .buffer = buffer,
+                .bufferSize = sizeof buffer,
+            };
+
+        asserteq(cla_compileSchema(&schema), cla_noErrors);
+        /* Excludes trailing 'XXXX' and terminator. */
+        asserteq(cla_parseBuffer(&schema, &result, buffer, sizeof buffer - 5), cla_noErrors);
+        asserteq(cla_get(&result, &options[0]), cla_noErrors);
+        asserteq(jobs, 42, "recorded argument was not bounded by its length");
+        asserteq(cla_beginStream(&stream), cla_illegalInputError, "lazy stream was not rejected");
+    }
+
+    it("does nothing for eager results") {
+        char
+            *argv[] = {"binary", "--jobs=5"},
+            *arguments[1];
+        uint64_t
+            references[cla_numberOfWords(1)];
+        size_t
+            jobs = 0;
+        cla_option_t
+            options[] = {{
+                    .name = "jobs",
+                    .handler = &countingHandler,
+                    .valuePtr = &jobs,
+                },
+            };
+        cla_slot_t
+            slots[cla_numberOfSlots(1)];
+        cla_schema_t
+            schema = {
+                .options = options,
+                .numberOfOptions = sizeof options / sizeof *options,
+                .slots = slots,
+                .numberOfSlots = sizeof slots / sizeof *slots,
+            };
+        cla_result_t
+            result = {
+                .arguments = arguments,
+                .references = references,
+            };
+
+        numberOfCalls = 0;
+
+        asserteq(cla_compileSchema(&schema), cla_noErrors);
+        asserteq(cla_parse(&schema, &result, 2, argv), cla_noErrors);
+        asserteq(cla_get(&result, &options[0]), cla_noErrors);
+        asserteq(jobs, 5, "integer option value was not decoded");
+        asserteq(numberOfCalls, 1, "eager value was decoded again");
+    }
+}
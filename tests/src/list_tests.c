@@ -0,0 +1,238 @@
+#include <clarum/clarum.h>
+#include <snow/snow.h>
+#include <stdio.h>
+#include <string.h>
+
+describe(list) {
+    it("accumulates repeated and separated values") {
+        char
+            *argv[] = {"binary", "--include=a", "--tags=x,,yz", "-I", "--include=b,c"},
+            *arguments[2];
+        _Alignas(16) char
+            buffer[512];
+        uint64_t
+            references[cla_numberOfWords(2)];
+        cla_list_t
+            includes = {
+                .separator = '\0',
+            },
+            tags = {
+                .separator = ',',
+            };
+        cla_option_t
+            options[] = {{
+                    .tag = 'I',
+                    .name = "include",
+                    .handler = &cla_listHandler,
+                    .valuePtr = &includes,
+                }, {
+                    .name = "tags",
+                    .handler = &cla_listHandler,
+                    .valuePtr = &tags,
+                },
+            };
+        cla_slot_t
+            slots[cla_numberOfSlots(2)];
+        cla_schema_t
+            schema = {
+                .options = options,
+                .numberOfOptions = sizeof options / sizeof *options,
+                .slots = slots,
+                .numberOfSlots = sizeof slots / sizeof *slots,
+            };
+        cla_result_t
+            result = {
+                .arguments = arguments,
+                .references = references,
+                .arena = {
+                    .buffer = buffer,
+                    .bufferSize = sizeof buffer,
+                },
+            };
+        cla_slice_t const
+            *items;
+
+        asserteq(cla_compileSchema(&schema), cla_noErrors);
+        /* Tag without value has no argument. */
+        asserteq(cla_parse(&schema, &result, 5, argv), cla_nullReferenceError, "missing argument was accepted");
+        argv[3] = "-I=";
+        asserteq(cla_parse(&schema, &result, 5, argv), cla_noErrors);
+
+        items = includes.items;
+        asserteq(includes.numberOfItems, 3, "repeated values were not accumulated");
+        assert((char *) includes.items >= buffer && (char *) includes.items < buffer + sizeof buffer);
+        asserteq(items[0].length, 1);
+        asserteq_ptr(items[0].data, argv[1] + 10, "value was copied");
+        asserteq(items[1].length, 0, "empty value was not kept");
+        asserteq(items[2].length, 3, "value was split without separator");
+
+        items = tags.items;
+        asserteq(tags.numberOfItems, 3, "separated values were not split");
+        asserteq(items[0].length, 1);
+        asserteq(items[1].length, 0, "empty part was not kept");
+        asserteq(items[2].length, 2);
+        asserteq(strncmp(items[2].data, "yz", 2), 0);
+
+        cla_releaseResult(&result);
+        asserteq(includes.numberOfItems, 0, "list was not emptied");
+        asserteq_ptr(includes.items, NULL, "items were not freed");
+        asserteq(tags.separator, ',', "separator was reset");
+    }
+
+    it("grows contiguous storage over many values") {
+        enum {
+            numberOfValues = 5000,
+        };
+        static char
+            values[numberOfValues][24],
+            *argv[numberOfValues + 1];
+        char
+            *arguments[2];
+        uint64_t
+            references[cla_numberOfWords(2)];
+        cla_list_t
+            defines = {
+                .separator = '\0',
+            },
+            numbers = {
+                .separator = ',',
+            };
+        cla_option_t
+            options[] = {{
+                    .name = "define",
+                    .handler = &cla_listHandler,
+                    .valuePtr = &defines,
+                }, {
+                    .name = "number",
+                    .handler = &cla_int32ListHandler,
+                    .valuePtr = &numbers,
+                },
+            };
+        cla_slot_t
+            slots[cla_numberOfSlots(2)];
+        cla_schema_t
+            schema = {
+                .options = options,
+                .numberOfOptions = sizeof options / sizeof *options,
+                .slots = slots,
+                .numberOfSlots = sizeof slots / sizeof *slots,
+            };
+        cla_result_t
+            result = {
+                .arguments = arguments,
+                .references = references,
+                .arena = {
+                    .allocator = &cla_heapAllocator,
+                },
+            };
+        cla_slice_t const
+            *slices;
+        int32_t const
+            *integers;
+
+        argv[0] = "binary";
+        for (size_t i = 0; i < numberOfValues; ++i) {
+            /* Interleaves both lists, so neither grows in place all the time. */
+            snprintf(values[i], sizeof values[i], i % 3 ? "--define=%zu" : "--number=%zu,-%zu", i, i);
+            argv[i + 1] = values[i];
+        }
+
+        asserteq(cla_compileSchema(&schema), cla_noErrors);
+
+        for (size_t pass = 0; pass < 2; ++pass) {
+            asserteq(cla_parse(&schema, &result, numberOfValues + 1, argv), cla_noErrors);
+            asserteq(defines.numberOfItems, numberOfValues - (numberOfValues + 2) / 3, "values were lost");
+            asserteq(numbers.numberOfItems, 2 * ((numberOfValues + 2) / 3), "values were lost");
+
+            slices = defines.items;
+            integers = numbers.items;
+            for (size_t i = 0, j = 0, k = 0; i < numberOfValues; ++i)
+                if (i % 3) {
+                    asserteq_ptr(slices[j++].data, values[i] + 9, "value was copied");
+                } else {
+                    asserteq(integers[k++], (int32_t) i, "value was not decoded");
+                    asserteq(integers[k++], -(int32_t) i, "value was not decoded");
+                }
+        }
+
+        cla_releaseResult(&result);
+    }
+
+    it("decodes typed lists") {
+        char
+            *argv[] = {"binary", "--big=18446744073709551615,0x10", "--small=1,4294967296"},
+            *arguments[2];
+        _Alignas(16) char
+            buffer[512];
+        uint64_t
+            references[cla_numberOfWords(2)];
+        cla_list_t
+            big = {
+                .separator = ',',
+            },
+            small = {
+                .separator = ',',
+            };
+        cla_option_t
+            options[] = {{
+                    .name = "big",
+                    .handler = &cla_uint64ListHandler,
+                    .valuePtr = &big,
+                }, {
+                    .name = "small",
+                    .handler = &cla_uint32ListHandler,
+                    .valuePtr = &small,
+                },
+            };
+        cla_slot_t
+            slots[cla_numberOfSlots(2)];
+        cla_schema_t
+            schema = {
+                .options = options,
+                .numberOfOptions = sizeof options / sizeof *options,
+                .slots = slots,
+                .numberOfSlots = sizeof slots / sizeof *slots,
+            };
+        cla_result_t
+            result = {
+                .arguments = arguments,
+                .references = references,
+                .arena = {
+                    .buffer = buffer,
+                    .bufferSize = sizeof buffer,
+                },
+            };
+
+        asserteq(cla_compileSchema(&schema), cla_noErrors);
+        asserteq(cla_parse(&schema, &result, 3, argv), cla_illegalInputError, "overflow was accepted");
+        asserteq(big.numberOfItems, 2);
+        asserteq(((uint64_t *) big.items)[0], UINT64_MAX);
+        asserteq(((uint64_t *) big.items)[1], 16);
+        asserteq(small.numberOfItems, 1, "invalid value was appended");
+
+        cla_releaseResult(&result);
+    }
+
+    it("requires result") {
+        char
+            *argv[] = {"binary", "--include=a"};
+        cla_list_t
+            includes = {
+                .separator = ',',
+            };
+        cla_option_t
+            options[] = {{
+                    .name = "include",
+                    .handler = &cla_listHandler,
+                    .valuePtr = &includes,
+                },
+            };
+        cla_parser_t
+            parser = {
+                .options = options,
+                .numberOfOptions = sizeof options / sizeof *options,
+            };
+
+        asserteq(cla_parseOptions(&parser, 2, argv), cla_nullReferenceError, "list was filled without storage");
+    }
+}
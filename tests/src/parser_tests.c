@@ -1,5 +1,6 @@
 #include <clarum/clarum.h>
 #include <snow/snow.h>
+#include <string.h>
 
 describe(parser) {
     it("parses long string option") {
@@ -339,4 +340,44 @@ describe(parser) {
         asserteq(booleanValueC, true, "boolean option C value was not decoded");
         asserteq(stringValue, "foo", "string option value was not set");
     }
+
+    it("splits long arguments regardless of alignment") {
+        char
+            name[] = "option-with-a-name-long-enough-to-span-several-blocks-of-any-scan-width",
+            buffer[sizeof name + 4096 + 64],
+            *argv[] = {"binary", NULL},
+            *value = NULL;
+        int
+            argc = sizeof argv / sizeof *argv;
+        cla_option_t
+            options[] = {{
+                    .name = name,
+                    .handler = &cla_stringHandler,
+                    .valuePtr = &value,
+                },
+            };
+        size_t const
+            numberOfOptions = sizeof options / sizeof *options,
+            nameLength = sizeof name - 1;
+
+        for (size_t offset = 0; offset < 64; ++offset) {
+            cla_parser_t
+                parser = {
+                    .options = options,
+                    .numberOfOptions = numberOfOptions,
+                };
+            char
+                *argument = &buffer[offset];
+
+            memset(argument, 'q', 4096);
+            memcpy(argument, "--", 2);
+            memcpy(&argument[2], name, nameLength);
+            memcpy(&argument[2 + nameLength], "=a=b", 4);
+            argument[4095] = '\0';
+            argv[1] = argument;
+
+            asserteq(cla_parseOptions(&parser, argc, argv), cla_noErrors);
+            asserteq_ptr(value, &argument[3 + nameLength], "option value does not point past first delimiter");
+        }
+    }
 }
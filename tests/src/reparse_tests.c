@@ -0,0 +1,195 @@
+#include <clarum/clarum.h>
+#include <snow/snow.h>
+
+static size_t
+    numberOfCalls;
+
+static int
+countingHandler(
+    cla_parser_t *parser,
+    cla_option_t *option
+) {
+    ++numberOfCalls;
+    return cla_integerHandler(parser, option);
+}
+
+describe(reparse) {
+    it("checks for null pointers and lazy results") {
+        char
+            *argv[] = {"binary", "--jobs=1"},
+            *arguments[1];
+        uint64_t
+            references[cla_numberOfWords(1)],
+            decodedOptions[cla_numberOfWords(1)],
+            changedOptions[cla_numberOfWords(1)];
+        size_t
+            argumentLengths[1];
+        cla_option_t
+            options[] = {{
+                    .name = "jobs",
+                },
+            };
+        cla_slot_t
+            slots[cla_numberOfSlots(1)];
+        cla_schema_t
+            schema = {
+                .options = options,
+                .numberOfOptions = sizeof options / sizeof *options,
+                .slots = slots,
+                .numberOfSlots = sizeof slots / sizeof *slots,
+            };
+        cla_result_t
+            eager = {
+                .arguments = arguments,
+                .references = references,
+            },
+            lazy = {
+                .arguments = arguments,
+                .references = references,
+                .argumentLengths = argumentLengths,
+                .decodedOptions = decodedOptions,
+            };
+
+        asserteq(cla_compileSchema(&schema), cla_noErrors);
+        asserteq(cla_reparse(NULL, NULL, &lazy, 2, argv, changedOptions), cla_nullReferenceError, "@schema was not checked for NULL");
+        asserteq(cla_reparse(&schema, NULL, NULL, 2, argv, changedOptions), cla_nullReferenceError, "@result was not checked for NULL");
+        asserteq(cla_reparse(&schema, NULL, &lazy, 2, NULL, changedOptions), cla_nullReferenceError, "@argv was not checked for NULL");
+        asserteq(cla_reparse(&schema, NULL, &lazy, 2, argv, NULL), cla_nullReferenceError, "@changedOptions was not checked for NULL");
+        asserteq(cla_reparse(&schema, NULL, &eager, 2, argv, changedOptions), cla_illegalInputError, "eager result was accepted");
+        asserteq(cla_parse(&schema, &eager, 2, argv), cla_noErrors);
+        asserteq(cla_reparse(&schema, &eager, &lazy, 2, argv, changedOptions), cla_illegalInputError, "eager previous result was accepted");
+    }
+
+    it("runs handlers of added and changed options only") {
+        char
+            *first[] = {"binary", "--a=1", "--b=2", "--c=3", "--flag"},
+            *second[] = {"binary", "--a=1", "--b=20", "--d=4", "--flag="},
+            *arguments[2][5];
+        uint64_t
+            references[2][cla_numberOfWords(5)],
+            decodedOptions[2][cla_numberOfWords(5)],
+            changedOptions[cla_numberOfWords(5)];
+        size_t
+            argumentLengths[2][5],
+            a = 0,
+            b = 0,
+            c = 0,
+            d = 0;
+        cla_option_t
+            options[] = {{
+                    .name = "a",
+                    .handler = &countingHandler,
+                    .valuePtr = &a,
+                }, {
+                    .name = "b",
+                    .handler = &countingHandler,
+                    .valuePtr = &b,
+                }, {
+                    .name = "c",
+                    .handler = &countingHandler,
+                    .valuePtr = &c,
+                    .valueSize = sizeof c,
+                }, {
+                    .name = "d",
+                    .handler = &countingHandler,
+                    .valuePtr = &d,
+                }, {
+                    .name = "flag",
+                },
+            };
+        cla_slot_t
+            slots[cla_numberOfSlots(5)];
+        cla_schema_t
+            schema = {
+                .options = options,
+                .numberOfOptions = sizeof options / sizeof *options,
+                .slots = slots,
+                .numberOfSlots = sizeof slots / sizeof *slots,
+            };
+        cla_result_t
+            results[2] = {{
+                    .arguments = arguments[0],
+                    .references = references[0],
+                    .argumentLengths = argumentLengths[0],
+                    .decodedOptions = decodedOptions[0],
+                }, {
+                    .arguments = arguments[1],
+                    .references = references[1],
+                    .argumentLengths = argumentLengths[1],
+                    .decodedOptions = decodedOptions[1],
+                },
+            };
+
+        asserteq(cla_compileSchema(&schema), cla_noErrors);
+
+        numberOfCalls = 0;
+        asserteq(cla_reparse(&schema, NULL, &results[0], 5, first, changedOptions), cla_noErrors);
+        asserteq(numberOfCalls, 3, "initial load did not decode every option");
+        asserteq(changedOptions[0], 0x17u);
+        asserteq(a + b + c, 6);
+
+        numberOfCalls = 0;
+        asserteq(cla_reparse(&schema, &results[0], &results[1], 5, second, changedOptions), cla_noErrors);
+        asserteq(numberOfCalls, 2, "unchanged option was decoded again");
+        asserteq(changedOptions[0], 0x1Eu, "changed set is wrong");
+        asserteq(b, 20);
+        asserteq(d, 4);
+        asserteq(c, 0, "holder of removed option was not reset");
+        assert(decodedOptions[1][0] & 1, "unchanged option did not inherit decoded state");
+
+        numberOfCalls = 0;
+        asserteq(cla_reparse(&schema, &results[1], &results[0], 5, second, changedOptions), cla_noErrors);
+        asserteq(numberOfCalls, 0, "identical reload ran handlers");
+        asserteq(changedOptions[0], 0);
+    }
+
+    it("reports failing handlers of changed options") {
+        char
+            *first[] = {"binary", "--a=1"},
+            *second[] = {"binary", "--a=x"},
+            *arguments[2][1];
+        uint64_t
+            references[2][1],
+            decodedOptions[2][1],
+            changedOptions[1];
+        size_t
+            argumentLengths[2][1],
+            a = 0;
+        cla_option_t
+            options[] = {{
+                    .name = "a",
+                    .handler = &countingHandler,
+                    .valuePtr = &a,
+                },
+            };
+        cla_slot_t
+            slots[cla_numberOfSlots(1)];
+        cla_schema_t
+            schema = {
+                .options = options,
+                .numberOfOptions = 1,
+                .slots = slots,
+                .numberOfSlots = sizeof slots / sizeof *slots,
+            };
+        cla_result_t
+            results[2] = {{
+                    .arguments = arguments[0],
+                    .references = references[0],
+                    .argumentLengths = argumentLengths[0],
+                    .decodedOptions = decodedOptions[0],
+                }, {
+                    .arguments = arguments[1],
+                    .references = references[1],
+                    .argumentLengths = argumentLengths[1],
+                    .decodedOptions = decodedOptions[1],
+                },
+            };
+
+        asserteq(cla_compileSchema(&schema), cla_noErrors);
+        asserteq(cla_reparse(&schema, NULL, &results[0], 2, first, changedOptions), cla_noErrors);
+        asserteq(cla_reparse(&schema, &results[0], &results[1], 2, second, changedOptions), cla_illegalInputError);
+        asserteq(results[1].status, cla_illegalInputError);
+        asserteq(changedOptions[0], 0, "partial changes were reported after failure");
+        asserteq(a, 1);
+    }
+}
@@ -0,0 +1,236 @@
+#include <clarum/clarum.h>
+#include <snow/snow.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+static void
+writeResponseFile(
+    char *path,
+    char const *contents,
+    size_t size
+) {
+    int
+        descriptor;
+
+    strcpy(path, "/tmp/clarum-response-XXXXXX");
+    descriptor = mkstemp(path);
+
+    if (descriptor >= 0) {
+        ssize_t const
+            written = write(descriptor, contents, size);
+
+        (void) written;
+        close(descriptor);
+    }
+}
+
+describe(response) {
+    it("expands response files in place") {
+        char
+            path[64],
+            argument[72],
+            *argv[] = {"binary", "--jobs=2", argument, "--verbose"},
+            *arguments[3],
+            *filter = NULL;
+        char const
+            contents[] = "--filter='a b'\n  --name=\"quoted \\\"word\\\"\"\t--jobs=4 ";
+        int
+            argc = sizeof argv / sizeof *argv;
+        uint64_t
+            references[cla_numberOfWords(3)];
+        size_t
+            jobs = 0;
+        char
+            *name = NULL;
+        cla_mapping_t
+            mappings[1];
+        cla_option_t
+            options[] = {{
+                    .name = "filter",
+                    .handler = &cla_stringHandler,
+                    .valuePtr = &filter,
+                }, {
+                    .name = "name",
+                    .handler = &cla_stringHandler,
+                    .valuePtr = &name,
+                }, {
+                    .name = "jobs",
+                    .handler = &cla_integerHandler,
+                    .valuePtr = &jobs,
+                },
+            };
+        cla_slot_t
+            slots[cla_numberOfSlots(3)];
+        cla_schema_t
+            schema = {
+                .options = options,
+                .numberOfOptions = sizeof options / sizeof *options,
+                .slots = slots,
+                .numberOfSlots = sizeof slots / sizeof *slots,
+                .isLenient = true,
+            };
+        cla_result_t
+            result = {
+                .arguments = arguments,
+                .references = references,
+                .mappings = mappings,
+                .maximumNumberOfMappings = sizeof mappings / sizeof *mappings,
+            };
+
+        writeResponseFile(path, contents, sizeof contents - 1);
+        snprintf(argument, sizeof argument, "@%s", path);
+
+        asserteq(cla_compileSchema(&schema), cla_noErrors);
+        asserteq(cla_parse(&schema, &result, argc, argv), cla_noErrors);
+        asserteq(result.numberOfMappings, 1, "response file was not mapped");
+        asserteq_str(filter, "a b", "single-quoted value was not unquoted");
+        asserteq_str(name, "quoted \"word\"", "double-quoted value was not unescaped");
+        asserteq(jobs, 4, "later value did not override earlier one");
+        assert(filter >= mappings[0].address && filter < mappings[0].address + mappings[0].size);
+
+        cla_releaseResult(&result);
+        asserteq(result.numberOfMappings, 0, "response file was not released");
+        unlink(path);
+    }
+
+    it("terminates last word of page-sized file") {
+        char
+            path[64],
+            argument[72],
+            *argv[] = {"binary", argument},
+            *arguments[1],
+            *contents = malloc(4096),
+            *value = NULL;
+        uint64_t
+            references[cla_numberOfWords(1)];
+        cla_mapping_t
+            mappings[1];
+        cla_option_t
+            options[] = {{
+                    .name = "value",
+                    .handler = &cla_stringHandler,
+                    .valuePtr = &value,
+                },
+            };
+        cla_slot_t
+            slots[cla_numberOfSlots(1)];
+        cla_schema_t
+            schema = {
+                .options = options,
+                .numberOfOptions = sizeof options / sizeof *options,
+                .slots = slots,
+                .numberOfSlots = sizeof slots / sizeof *slots,
+            };
+        cla_result_t
+            result = {
+                .arguments = arguments,
+                .references = references,
+                .mappings = mappings,
+                .maximumNumberOfMappings = sizeof mappings / sizeof *mappings,
+            };
+
+        memset(contents, 'v', 4096);
+        memcpy(contents, "--value=", 8);
+        writeResponseFile(path, contents, 4096);
+        snprintf(argument, sizeof argument, "@%s", path);
+
+        asserteq(cla_compileSchema(&schema), cla_noErrors);
+        asserteq(cla_parse(&schema, &result, 2, argv), cla_noErrors);
+        asserteq(strlen(value), 4096 - 8, "last word was not terminated");
+
+        cla_releaseResult(&result);
+        unlink(path);
+        free(contents);
+    }
+
+    it("limits nesting depth") {
+        char
+            path[64],
+            argument[72],
+            *argv[] = {"binary", argument},
+            *arguments[1];
+        uint64_t
+            references[cla_numberOfWords(1)];
+        cla_mapping_t
+            mappings[cla_maximumResponseFileDepth + 1];
+        cla_option_t
+            options[] = {{
+                    .name = "foo",
+                },
+            };
+        cla_slot_t
+            slots[cla_numberOfSlots(1)];
+        cla_schema_t
+            schema = {
+                .options = options,
+                .numberOfOptions = sizeof options / sizeof *options,
+                .slots = slots,
+                .numberOfSlots = sizeof slots / sizeof *slots,
+            };
+        cla_result_t
+            result = {
+                .arguments = arguments,
+                .references = references,
+                .mappings = mappings,
+                .maximumNumberOfMappings = sizeof mappings / sizeof *mappings,
+            };
+        FILE
+            *file;
+
+        /* Response file references itself. */
+        writeResponseFile(path, "", 0);
+        snprintf(argument, sizeof argument, "@%s", path);
+        file = fopen(path, "w");
+        fprintf(file, "--foo %s\n", argument);
+        fclose(file);
+
+        asserteq(cla_compileSchema(&schema), cla_noErrors);
+        asserteq(cla_parse(&schema, &result, 2, argv), cla_illegalInputError, "recursion was not stopped");
+        asserteq(result.numberOfMappings, cla_maximumResponseFileDepth, "nesting was not limited");
+
+        cla_releaseResult(&result);
+        unlink(path);
+    }
+
+    it("reports unavailable response files") {
+        char
+            *argv[] = {"binary", "@/nonexistent/clarum/response"},
+            *arguments[1];
+        uint64_t
+            references[cla_numberOfWords(1)];
+        cla_mapping_t
+            mappings[1];
+        cla_option_t
+            options[] = {{
+                    .name = "foo",
+                },
+            };
+        cla_slot_t
+            slots[cla_numberOfSlots(1)];
+        cla_schema_t
+            schema = {
+                .options = options,
+                .numberOfOptions = sizeof options / sizeof *options,
+                .slots = slots,
+                .numberOfSlots = sizeof slots / sizeof *slots,
+            };
+        cla_result_t
+            result = {
+                .arguments = arguments,
+                .references = references,
+                .mappings = mappings,
+                .maximumNumberOfMappings = sizeof mappings / sizeof *mappings,
+            },
+            unexpanded = {
+                .arguments = arguments,
+                .references = references,
+            };
+
+        asserteq(cla_compileSchema(&schema), cla_noErrors);
+        asserteq(cla_parse(&schema, &result, 2, argv), cla_fileError, "missing file was not reported");
+        asserteq(cla_parse(&schema, &unexpanded, 2, argv), cla_noErrors, "response file was expanded without storage");
+        asserteq_str(unexpanded.next, argv[1], "response file was not treated as operand");
+    }
+}
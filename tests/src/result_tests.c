@@ -0,0 +1,199 @@
+#include <clarum/clarum.h>
+#include <snow/snow.h>
+
+describe(result) {
+    it("checks for null pointers") {
+        char
+            *argv[] = {"binary"},
+            *arguments[1];
+        uint64_t
+            references[1];
+        int
+            argc = sizeof argv / sizeof *argv;
+        cla_option_t
+            options[] = {{
+                    .name = "foo",
+                },
+            };
+        cla_slot_t
+            slots[cla_numberOfSlots(1)];
+        cla_schema_t
+            schema = {
+                .options = options,
+                .numberOfOptions = sizeof options / sizeof *options,
+                .slots = slots,
+                .numberOfSlots = sizeof slots / sizeof *slots,
+            };
+        cla_result_t
+            result = {
+                .arguments = arguments,
+                .references = references,
+            },
+            empty = {
+                .arguments = NULL,
+            };
+
+        asserteq(cla_compileSchema(&schema), cla_noErrors);
+        asserteq(cla_parse(NULL, &result, argc, argv), cla_nullReferenceError, "@schema was not checked for NULL");
+        asserteq(cla_parse(&schema, NULL, argc, argv), cla_nullReferenceError, "@result was not checked for NULL");
+        asserteq(cla_parse(&schema, &result, argc, NULL), cla_nullReferenceError, "@argv was not checked for NULL");
+        asserteq(cla_parse(&schema, &empty, argc, argv), cla_nullReferenceError, "result storage was not checked for NULL");
+    }
+
+    it("leaves options intact") {
+        char
+            *argv[] = {"binary", "--foo=bar", "operand"},
+            *arguments[1];
+        uint64_t
+            references[cla_numberOfWords(1)];
+        int
+            argc = sizeof argv / sizeof *argv;
+        cla_option_t
+            options[] = {{
+                    .name = "foo",
+                },
+            };
+        cla_slot_t
+            slots[cla_numberOfSlots(1)];
+        cla_schema_t
+            schema = {
+                .options = options,
+                .numberOfOptions = sizeof options / sizeof *options,
+                .slots = slots,
+                .numberOfSlots = sizeof slots / sizeof *slots,
+            };
+        cla_result_t
+            result = {
+                .arguments = arguments,
+                .references = references,
+            };
+
+        asserteq(cla_compileSchema(&schema), cla_noErrors);
+        asserteq(cla_parse(&schema, &result, argc, argv), cla_noErrors);
+        asserteq(cla_isReferenced(&result, 0), true, "option was not reported as referenced");
+        asserteq_str(result.arguments[0], "bar", "option argument was not recorded");
+        asserteq_str(result.next, "operand", "first unprocessed option was not recorded");
+        asserteq(options[0].isReferenced, false, "option was modified");
+        asserteq_ptr(options[0].argument, NULL, "option was modified");
+    }
+
+    it("resets between parses") {
+        char
+            *first[] = {"binary", "--foo"},
+            *second[] = {"binary", "--bar"},
+            *arguments[2];
+        uint64_t
+            references[cla_numberOfWords(2)];
+        cla_option_t
+            options[] = {{
+                    .name = "foo",
+                }, {
+                    .name = "bar",
+                },
+            };
+        cla_slot_t
+            slots[cla_numberOfSlots(2)];
+        cla_schema_t
+            schema = {
+                .options = options,
+                .numberOfOptions = sizeof options / sizeof *options,
+                .slots = slots,
+                .numberOfSlots = sizeof slots / sizeof *slots,
+            };
+        cla_result_t
+            result = {
+                .arguments = arguments,
+                .references = references,
+            };
+
+        asserteq(cla_compileSchema(&schema), cla_noErrors);
+        asserteq(cla_parse(&schema, &result, 2, first), cla_noErrors);
+        asserteq(cla_isReferenced(&result, 0), true, "first option was not reported as referenced");
+        asserteq(cla_parse(&schema, &result, 2, second), cla_noErrors);
+        asserteq(cla_isReferenced(&result, 0), false, "first option was not reset");
+        asserteq(cla_isReferenced(&result, 1), true, "second option was not reported as referenced");
+    }
+
+    it("decodes values into per-result holders") {
+        char
+            *first[] = {"binary", "--jobs=4"},
+            *second[] = {"binary", "--jobs=8"},
+            *arguments[1];
+        uint64_t
+            references[cla_numberOfWords(1)];
+        size_t
+            firstJobs = 0,
+            secondJobs = 0;
+        void
+            *firstValues[] = {&firstJobs},
+            *secondValues[] = {&secondJobs};
+        cla_option_t
+            options[] = {{
+                    .name = "jobs",
+                    .handler = &cla_integerHandler,
+                },
+            };
+        cla_slot_t
+            slots[cla_numberOfSlots(1)];
+        cla_schema_t
+            schema = {
+                .options = options,
+                .numberOfOptions = sizeof options / sizeof *options,
+                .slots = slots,
+                .numberOfSlots = sizeof slots / sizeof *slots,
+            };
+        cla_result_t
+            firstResult = {
+                .arguments = arguments,
+                .references = references,
+                .values = firstValues,
+            },
+            secondResult = {
+                .arguments = arguments,
+                .references = references,
+                .values = secondValues,
+            };
+
+        asserteq(cla_compileSchema(&schema), cla_noErrors);
+        asserteq(cla_parse(&schema, &firstResult, 2, first), cla_noErrors);
+        asserteq(cla_parse(&schema, &secondResult, 2, second), cla_noErrors);
+        asserteq(firstJobs, 4, "first value was not decoded");
+        asserteq(secondJobs, 8, "second value was not decoded");
+    }
+
+    it("reports missing options") {
+        char
+            *argv[] = {"binary", "--foo", "--foo"},
+            *arguments[2];
+        uint64_t
+            references[cla_numberOfWords(2)];
+        int
+            argc = sizeof argv / sizeof *argv;
+        cla_option_t
+            options[] = {{
+                    .name = "foo",
+                    .isRequired = true,
+                }, {
+                    .name = "bar",
+                    .isRequired = true,
+                },
+            };
+        cla_slot_t
+            slots[cla_numberOfSlots(2)];
+        cla_schema_t
+            schema = {
+                .options = options,
+                .numberOfOptions = sizeof options / sizeof *options,
+                .slots = slots,
+                .numberOfSlots = sizeof slots / sizeof *slots,
+            };
+        cla_result_t
+            result = {
+                .arguments = arguments,
+                .references = references,
+            };
+
+        asserteq(cla_compileSchema(&schema), cla_noErrors);
+        asserteq(cla_parse(&schema, &result, argc, argv), cla_missingOptionError, "error was not returned");
+    }
+}
@@ -0,0 +1,236 @@
+#include <clarum/clarum.h>
+#include <snow/snow.h>
+
+describe(schema) {
+    it("checks for null pointers") {
+        cla_option_t
+            options[] = {{
+                    .name = "foo",
+                },
+            };
+        cla_schema_t
+            schema = {
+                .options = options,
+                .numberOfOptions = sizeof options / sizeof *options,
+            };
+
+        asserteq(cla_compileSchema(NULL), cla_nullReferenceError, "@schema was not checked for NULL");
+        asserteq(cla_compileSchema(&schema), cla_nullReferenceError, "slots were not checked for NULL");
+    }
+
+    it("checks number of slots") {
+        cla_option_t
+            options[] = {{
+                    .name = "foo",
+                }, {
+                    .name = "bar",
+                },
+            };
+        cla_slot_t
+            slots[2];
+        cla_schema_t
+            schema = {
+                .options = options,
+                .numberOfOptions = sizeof options / sizeof *options,
+                .slots = slots,
+                .numberOfSlots = sizeof slots / sizeof *slots,
+            };
+
+        asserteq(cla_compileSchema(&schema), cla_illegalInputError, "insufficient number of slots was accepted");
+    }
+
+    it("rejects ambiguous names") {
+        cla_option_t
+            options[] = {{
+                    .name = "foo",
+                    .synonym = "bar",
+                }, {
+                    .name = "bar",
+                },
+            };
+        cla_slot_t
+            slots[cla_numberOfSlots(2)];
+        cla_schema_t
+            schema = {
+                .options = options,
+                .numberOfOptions = sizeof options / sizeof *options,
+                .slots = slots,
+                .numberOfSlots = sizeof slots / sizeof *slots,
+            };
+
+        asserteq(cla_compileSchema(&schema), cla_illegalInputError, "duplicate name was accepted");
+    }
+
+    it("resolves names and synonyms via index") {
+        char
+            *argv[] = {"binary", "--threads=4", "--filter=*.c", "--recursive"};
+        int
+            argc = sizeof argv / sizeof *argv;
+        size_t
+            jobs = 0;
+        char
+            *filter = NULL;
+        bool
+            isRecursive = false;
+        cla_option_t
+            options[] = {{
+                    .name = "jobs",
+                    .synonym = "threads",
+                    .handler = &cla_integerHandler,
+                    .valuePtr = &jobs,
+                }, {
+                    .name = "filter",
+                    .synonym = "regexp",
+                    .handler = &cla_stringHandler,
+                    .valuePtr = &filter,
+                }, {
+                    .name = "recursive",
+                    .handler = &cla_booleanHandler,
+                    .valuePtr = &isRecursive,
+                },
+            };
+        size_t const
+            numberOfOptions = sizeof options / sizeof *options;
+        cla_slot_t
+            slots[cla_numberOfSlots(numberOfOptions)];
+        cla_schema_t
+            schema = {
+                .options = options,
+                .numberOfOptions = numberOfOptions,
+                .slots = slots,
+                .numberOfSlots = sizeof slots / sizeof *slots,
+            };
+        cla_parser_t
+            parser = {
+                .options = options,
+                .numberOfOptions = numberOfOptions,
+                .schema = &schema,
+            };
+
+        asserteq(cla_compileSchema(&schema), cla_noErrors);
+        asserteq(cla_parseOptions(&parser, argc, argv), cla_noErrors);
+        asserteq(options[0].isReferenced, true, "synonym was not resolved");
+        asserteq(options[1].isReferenced, true, "name was not resolved");
+        asserteq(options[2].isReferenced, true, "name without argument was not resolved");
+        asserteq(jobs, 4, "integer option value was not decoded");
+        asserteq_str(filter, "*.c", "string option value was not set");
+        asserteq(isRecursive, true, "boolean option value was not decoded");
+    }
+
+    it("matches names exactly") {
+        char
+            *argv[] = {"binary", "--foobar"};
+        int
+            argc = sizeof argv / sizeof *argv;
+        cla_option_t
+            options[] = {{
+                    .name = "foo",
+                },
+            };
+        size_t const
+            numberOfOptions = sizeof options / sizeof *options;
+        cla_slot_t
+            slots[cla_numberOfSlots(numberOfOptions)];
+        cla_schema_t
+            schema = {
+                .options = options,
+                .numberOfOptions = numberOfOptions,
+                .slots = slots,
+                .numberOfSlots = sizeof slots / sizeof *slots,
+            };
+        cla_parser_t
+            indexed = {
+                .options = options,
+                .numberOfOptions = numberOfOptions,
+                .schema = &schema,
+            },
+            scanned = {
+                .options = options,
+                .numberOfOptions = numberOfOptions,
+            };
+
+        asserteq(cla_compileSchema(&schema), cla_noErrors);
+        asserteq(cla_parseOptions(&indexed, argc, argv), cla_unknowOptionError, "prefix was resolved via index");
+        asserteq(cla_parseOptions(&scanned, argc, argv), cla_unknowOptionError, "prefix was resolved via scan");
+        asserteq(options[0].isReferenced, false, "option was reported as referenced");
+    }
+
+    it("rejects ambiguous tags") {
+        cla_option_t
+            options[] = {{
+                    .tag = 'f',
+                    .name = "foo",
+                }, {
+                    .tag = 'f',
+                    .name = "bar",
+                },
+            };
+        cla_slot_t
+            slots[cla_numberOfSlots(2)];
+        cla_schema_t
+            schema = {
+                .options = options,
+                .numberOfOptions = sizeof options / sizeof *options,
+                .slots = slots,
+                .numberOfSlots = sizeof slots / sizeof *slots,
+            };
+
+        asserteq(cla_compileSchema(&schema), cla_illegalInputError, "duplicate tag was accepted");
+    }
+
+    it("resolves bundled tags via table") {
+        char
+            *argv[] = {"binary", "-rvx", "-j=8"};
+        int
+            argc = sizeof argv / sizeof *argv;
+        bool
+            isRecursive = false,
+            isVerbose = false,
+            isExtended = false;
+        size_t
+            jobs = 0;
+        cla_option_t
+            options[] = {{
+                    .tag = 'r',
+                    .handler = &cla_booleanHandler,
+                    .valuePtr = &isRecursive,
+                }, {
+                    .tag = 'v',
+                    .handler = &cla_booleanHandler,
+                    .valuePtr = &isVerbose,
+                }, {
+                    .tag = 'x',
+                    .handler = &cla_booleanHandler,
+                    .valuePtr = &isExtended,
+                }, {
+                    .tag = 'j',
+                    .handler = &cla_integerHandler,
+                    .valuePtr = &jobs,
+                },
+            };
+        size_t const
+            numberOfOptions = sizeof options / sizeof *options;
+        cla_slot_t
+            slots[cla_numberOfSlots(numberOfOptions)];
+        cla_schema_t
+            schema = {
+                .options = options,
+                .numberOfOptions = numberOfOptions,
+                .slots = slots,
+                .numberOfSlots = sizeof slots / sizeof *slots,
+            };
+        cla_parser_t
+            parser = {
+                .options = options,
+                .numberOfOptions = numberOfOptions,
+                .schema = &schema,
+            };
+
+        asserteq(cla_compileSchema(&schema), cla_noErrors);
+        asserteq(cla_parseOptions(&parser, argc, argv), cla_noErrors);
+        asserteq(isRecursive, true, "boolean option R value was not decoded");
+        asserteq(isVerbose, true, "boolean option V value was not decoded");
+        asserteq(isExtended, true, "boolean option X value was not decoded");
+        asserteq(jobs, 8, "integer option value was not decoded");
+    }
+}
@@ -0,0 +1,184 @@
+#include <clarum/clarum.h>
+#include <snow/snow.h>
+#include <string.h>
+
+#if defined(CLARUM_STATISTICS)
+
+typedef struct {
+    int kinds[8];
+    cla_option_t const *options[8];
+    size_t numberOfEvents;
+} trace_t;
+
+static void
+recordEvent(
+    void *context,
+    cla_event_t const *event
+) {
+    trace_t
+        *trace = context;
+
+    if (trace->numberOfEvents < sizeof trace->kinds / sizeof *trace->kinds) {
+        trace->kinds[trace->numberOfEvents] = event->kind;
+        trace->options[trace->numberOfEvents] = event->option;
+    }
+
+    ++trace->numberOfEvents;
+}
+
+describe(statistics) {
+    it("counts arguments, lookups, comparisons, and handler calls") {
+        char
+            *argv[] = {"binary", "--jobs=12", "-v", "--name=foo", "operand"},
+            *arguments[3];
+        uint64_t
+            references[cla_numberOfWords(3)];
+        size_t
+            jobs = 0;
+        bool
+            isVerbose = false;
+        cla_option_t
+            options[] = {{
+                    .name = "jobs",
+                    .handler = &cla_integerHandler,
+                    .valuePtr = &jobs,
+                }, {
+                    .tag = 'v',
+                    .handler = &cla_booleanHandler,
+                    .valuePtr = &isVerbose,
+                }, {
+                    .name = "name",
+                },
+            };
+        cla_slot_t
+            slots[cla_numberOfSlots(3)];
+        cla_schema_t
+            schema = {
+                .options = options,
+                .numberOfOptions = sizeof options / sizeof *options,
+                .slots = slots,
+                .numberOfSlots = sizeof slots / sizeof *slots,
+            };
+        cla_result_t
+            result = {
+                .arguments = arguments,
+                .references = references,
+            };
+
+        asserteq(cla_compileSchema(&schema), cla_noErrors);
+        asserteq(cla_parse(&schema, &result, sizeof argv / sizeof *argv, argv), cla_noErrors);
+        asserteq(result.statistics.numberOfArguments, 4, "scanned arguments were not counted");
+        asserteq(result.statistics.numberOfLookups, 3, "lookups were not counted");
+        asserteq(result.statistics.numberOfComparisons, 2, "tags were compared, or names were not");
+        asserteq(result.statistics.numberOfHandlerCalls, 2, "handler calls were not counted");
+        assert(result.statistics.handlerTime <= result.statistics.parseTime, "handler time exceeds parse time");
+
+        /* Counters are reset by next parse. */
+        asserteq(cla_parse(&schema, &result, 2, argv), cla_noErrors);
+        asserteq(result.statistics.numberOfArguments, 1, "counters were not reset");
+        asserteq(result.statistics.numberOfHandlerCalls, 1, "counters were not reset");
+    }
+
+    it("traces tokens and handler calls") {
+        char
+            *argv[] = {"binary", "--jobs=12", "--unknown", "-v"},
+            *arguments[2];
+        uint64_t
+            references[cla_numberOfWords(2)];
+        size_t
+            jobs = 0;
+        cla_option_t
+            options[] = {{
+                    .name = "jobs",
+                    .handler = &cla_integerHandler,
+                    .valuePtr = &jobs,
+                }, {
+                    .tag = 'v',
+                },
+            };
+        cla_slot_t
+            slots[cla_numberOfSlots(2)];
+        cla_schema_t
+            schema = {
+                .options = options,
+                .numberOfOptions = sizeof options / sizeof *options,
+                .slots = slots,
+                .numberOfSlots = sizeof slots / sizeof *slots,
+                .isLenient = true,
+            };
+        trace_t
+            trace = {
+                .numberOfEvents = 0,
+            };
+        cla_result_t
+            result = {
+                .arguments = arguments,
+                .references = references,
+                .tracer = &recordEvent,
+                .tracerContext = &trace,
+            };
+
+        asserteq(cla_compileSchema(&schema), cla_noErrors);
+        asserteq(cla_parse(&schema, &result, sizeof argv / sizeof *argv, argv), cla_noErrors);
+        asserteq(trace.numberOfEvents, 4, "events were not reported per token and handler call");
+        asserteq(trace.kinds[0], cla_tokenEvent);
+        asserteq_ptr(trace.options[0], &options[0], "token was not resolved");
+        asserteq(trace.kinds[1], cla_handlerEvent);
+        asserteq_ptr(trace.options[1], &options[0], "handler event has wrong option");
+        asserteq(trace.kinds[2], cla_tokenEvent);
+        asserteq_ptr(trace.options[2], NULL, "unknown option was resolved");
+        asserteq(trace.kinds[3], cla_tokenEvent);
+        asserteq_ptr(trace.options[3], &options[1], "tag was not resolved");
+    }
+
+    it("accumulates counters over stream") {
+        char const
+            input[] = "--jobs=1\0--jobs=2\0";
+        char
+            buffer[16],
+            *arguments[1];
+        uint64_t
+            references[cla_numberOfWords(1)];
+        size_t
+            jobs = 0;
+        cla_option_t
+            options[] = {{
+                    .name = "jobs",
+                    .handler = &cla_integerHandler,
+                    .valuePtr = &jobs,
+                },
+            };
+        cla_slot_t
+            slots[cla_numberOfSlots(1)];
+        cla_schema_t
+            schema = {
+                .options = options,
+                .numberOfOptions = sizeof options / sizeof *options,
+                .slots = slots,
+                .numberOfSlots = sizeof slots / sizeof *slots,
+            };
+        cla_result_t
+            result = {
+                .arguments = arguments,
+                .references = references,
+            };
+        cla_stream_t
+            stream = {
+                .schema = &schema,
+                .result = &result,
+                .buffer = buffer,
+                .bufferSize = sizeof buffer,
+            };
+
+        asserteq(cla_compileSchema(&schema), cla_noErrors);
+        asserteq(cla_beginStream(&stream), cla_noErrors);
+        asserteq(cla_feed(&stream, input, 9), cla_noErrors);
+        asserteq(cla_feed(&stream, &input[9], sizeof input - 10), cla_noErrors);
+        asserteq(cla_finish(&stream), cla_noErrors);
+        asserteq(result.statistics.numberOfArguments, 2, "stream arguments were not counted");
+        asserteq(result.statistics.numberOfHandlerCalls, 2, "stream handler calls were not counted");
+        asserteq(jobs, 2, "last value was not decoded");
+    }
+}
+
+#endif
@@ -0,0 +1,187 @@
+#include <clarum/clarum.h>
+#include <snow/snow.h>
+#include <string.h>
+
+static size_t
+    numberOfCalls;
+
+static int
+countingHandler(
+    cla_parser_t *parser,
+    cla_option_t *option
+) {
+    ++numberOfCalls;
+    return cla_integerHandler(parser, option);
+}
+
+describe(stream) {
+    it("checks for null pointers") {
+        cla_stream_t
+            stream = {
+                .schema = NULL,
+            };
+
+        asserteq(cla_beginStream(NULL), cla_nullReferenceError, "@stream was not checked for NULL");
+        asserteq(cla_beginStream(&stream), cla_nullReferenceError, "stream schema was not checked for NULL");
+        asserteq(cla_feed(&stream, "", 0), cla_nullReferenceError, "stream schema was not checked for NULL");
+        asserteq(cla_finish(&stream), cla_nullReferenceError, "stream schema was not checked for NULL");
+    }
+
+    it("parses arguments split at any chunk boundary") {
+        char const
+            input[] = "--jobs=1\0-v\0--jobs=123456\0--name=abc";
+        char
+            buffer[32],
+            *arguments[3];
+        uint64_t
+            references[cla_numberOfWords(3)];
+        size_t
+            jobs = 0;
+        bool
+            isVerbose = false;
+        cla_option_t
+            options[] = {{
+                    .name = "jobs",
+                    .handler = &countingHandler,
+                    .valuePtr = &jobs,
+                }, {
+                    .tag = 'v',
+                    .handler = &cla_booleanHandler,
+                    .valuePtr = &isVerbose,
+                }, {
+                    .name = "name",
+                    .isRequired = true,
+                },
+            };
+        cla_slot_t
+            slots[cla_numberOfSlots(3)];
+        cla_schema_t
+            schema = {
+                .options = options,
+                .numberOfOptions = sizeof options / sizeof *options,
+                .slots = slots,
+                .numberOfSlots = sizeof slots / sizeof *slots,
+            };
+        cla_result_t
+            result = {
+                .arguments = arguments,
+                .references = references,
+            };
+        cla_stream_t
+            stream = {
+                .schema = &schema,
+                .result = &result,
+                .buffer = buffer,
+                .bufferSize = sizeof buffer,
+            };
+
+        asserteq(cla_compileSchema(&schema), cla_noErrors);
+
+        for (size_t chunkSize = 1; chunkSize <= sizeof input; ++chunkSize) {
+            numberOfCalls = 0;
+            jobs = 0;
+            isVerbose = false;
+
+            asserteq(cla_beginStream(&stream), cla_noErrors);
+
+            for (size_t i = 0; i < sizeof input - 1; i += chunkSize) {
+                size_t const
+                    length = sizeof input - 1 - i < chunkSize ? sizeof input - 1 - i : chunkSize;
+
+                asserteq(cla_feed(&stream, &input[i], length), cla_noErrors);
+            }
+
+            asserteq(cla_isReferenced(&result, 2), false, "unfinished argument was parsed");
+            asserteq(cla_finish(&stream), cla_noErrors);
+            asserteq(cla_isReferenced(&result, 2), true, "last argument was not parsed on finish");
+            asserteq(numberOfCalls, 2, "handler was not invoked per argument");
+            asserteq(jobs, 123456, "integer option value was not decoded");
+            asserteq(isVerbose, true, "boolean option value was not decoded");
+        }
+    }
+
+    it("supports custom separators") {
+        char const
+            input[] = "--jobs=7\n\n--unknown\n";
+        char
+            buffer[16],
+            *arguments[1];
+        uint64_t
+            references[cla_numberOfWords(1)];
+        size_t
+            jobs = 0;
+        cla_option_t
+            options[] = {{
+                    .name = "jobs",
+                    .handler = &cla_integerHandler,
+                    .valuePtr = &jobs,
+                },
+            };
+        cla_slot_t
+            slots[cla_numberOfSlots(1)];
+        cla_schema_t
+            schema = {
+                .options = options,
+                .numberOfOptions = sizeof options / sizeof *options,
+                .slots = slots,
+                .numberOfSlots = sizeof slots / sizeof *slots,
+            };
+        cla_result_t
+            result = {
+                .arguments = arguments,
+                .references = references,
+            };
+        cla_stream_t
+            stream = {
+                .schema = &schema,
+                .result = &result,
+                .buffer = buffer,
+                .bufferSize = sizeof buffer,
+                .separator = '\n',
+            };
+
+        asserteq(cla_compileSchema(&schema), cla_noErrors);
+        asserteq(cla_beginStream(&stream), cla_noErrors);
+        asserteq(cla_feed(&stream, input, sizeof input - 1), cla_unknowOptionError, "unknown option was not reported");
+        asserteq(jobs, 7, "integer option value was not decoded");
+        asserteq(cla_feed(&stream, input, sizeof input - 1), cla_unknowOptionError, "error was not retained");
+    }
+
+    it("bounds pending argument by buffer") {
+        char
+            buffer[4],
+            *arguments[1];
+        uint64_t
+            references[cla_numberOfWords(1)];
+        cla_option_t
+            options[] = {{
+                    .name = "foo",
+                },
+            };
+        cla_slot_t
+            slots[cla_numberOfSlots(1)];
+        cla_schema_t
+            schema = {
+                .options = options,
+                .numberOfOptions = sizeof options / sizeof *options,
+                .slots = slots,
+                .numberOfSlots = sizeof slots / sizeof *slots,
+            };
+        cla_result_t
+            result = {
+                .arguments = arguments,
+                .references = references,
+            };
+        cla_stream_t
+            stream = {
+                .schema = &schema,
+                .result = &result,
+                .buffer = buffer,
+                .bufferSize = sizeof buffer,
+            };
+
+        asserteq(cla_compileSchema(&schema), cla_noErrors);
+        asserteq(cla_beginStream(&stream), cla_noErrors);
+        asserteq(cla_feed(&stream, "--fo", 4), cla_outOfMemoryError, "pending argument overflowed buffer");
+    }
+}